@@ -0,0 +1,411 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../../DataStructures/DynamicArrays/DynamicArrayTemplate.h"
+#include "../../../DataStructures/Heaps/BinaryHeaps/HeapTemplate.h"
+#include "externalsort.h"
+#include "reader.h"
+
+/*****************************************************************
+ *  External merge sort.                                         *
+ *                                                               *
+ *  Sorts a file of native ints that does not fit in memory. The *
+ *  first phase reads the input in chunks of a third of the      *
+ *  memory, sorts each one and writes it to a temporary file, a  *
+ *  run. The second phase merges the runs with a min heap        *
+ *  holding the smallest unmerged element of each one. While the *
+ *  sort or the merge works on a block, the reader thread reads  *
+ *  the next one, so the disk is kept busy.                      *
+ *                                                               *
+ *  Each run being merged takes two blocks, and the output one,  *
+ *  so when there are too many runs for blocks of MIN_BLOCK      *
+ *  elements they are merged in groups into longer runs first.   *
+ ****************************************************************/
+/* Sorted run, in an unlinked temporary file. */
+typedef struct {
+    int fd;
+    long n;
+} Run;
+
+DEFINE_ARRAY(Run)
+
+/* Smallest element of each run on top, with the run it comes from. */
+DEFINE_HEAP(int, int, ADS_REVERSE_COMPARE)
+
+/* Flipping the sign bit orders ints as unsigned keys. */
+#define SIGN_BIT 0x80000000u
+
+/*****************************************************************
+ *  Auxiliary functions.                                         *
+ ****************************************************************/
+/* Returns the current time, in seconds. */
+static double now() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Writes a whole buffer to a file, retrying short writes. Returns 1
+   on success, 0 otherwise. */
+static int writeAll(int fd, const void *buffer, size_t size) {
+    const char *p = (const char *) buffer;
+    ssize_t written;
+
+    while (size > 0) {
+        if ((written = write(fd, p, size)) <= 0) {
+            return 0;
+        }
+
+        p += written;
+        size -= written;
+    }
+
+    return 1;
+}
+
+/* Creates an empty run in directory. The file is unlinked at once,
+   so it is deleted when closed, even if the program is killed.
+   Returns 1 on success, 0 otherwise. */
+static int createRun(const char *directory, Run *run) {
+    char path[PATH_MAX];
+
+    snprintf(path, sizeof(path), "%s/externalsort-XXXXXX", directory);
+    if ((run->fd = mkstemp(path)) < 0) {
+        return 0;
+    }
+    unlink(path);
+    run->n = 0;
+
+    return 1;
+}
+
+/* Closes the files of runs from first to last, excluded. */
+static void closeRuns(Array_Run *runs, int first, int last) {
+    int i;
+
+    for (i = first; i < last; i++) {
+        close(runs->info[i].fd);
+    }
+}
+
+/* Sorts n ints with a least significant digit radix sort, one byte
+   per pass, using scratch as a second buffer of n ints. Passes where
+   all elements have the same byte are skipped. */
+static void radixSort(int *data, int *scratch, long n) {
+    long counts[4][256], offset, c;
+    int *from = data, *to = scratch, *swap;
+    unsigned key;
+    int pass, digit, shift;
+    long i;
+
+    if (n < 2) {
+        return;
+    }
+
+    /* Counts the bytes of all passes in one read of the data. */
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < n; i++) {
+        key = (unsigned) data[i] ^ SIGN_BIT;
+        counts[0][key & 0xff]++;
+        counts[1][(key >> 8) & 0xff]++;
+        counts[2][(key >> 16) & 0xff]++;
+        counts[3][key >> 24]++;
+    }
+
+    for (pass = 0; pass < 4; pass++) {
+        shift = 8 * pass;
+        if (counts[pass][(((unsigned) from[0] ^ SIGN_BIT) >> shift) & 0xff] == n) {
+            continue;
+        }
+
+        /* Turns the counts into the first position of each byte. */
+        for (digit = 0, offset = 0; digit < 256; digit++) {
+            c = counts[pass][digit];
+            counts[pass][digit] = offset;
+            offset += c;
+        }
+
+        for (i = 0; i < n; i++) {
+            key = (unsigned) from[i] ^ SIGN_BIT;
+            to[counts[pass][(key >> shift) & 0xff]++] = from[i];
+        }
+
+        swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != data) {
+        memcpy(data, from, sizeof(int) * n);
+    }
+}
+
+/*****************************************************************
+ *  Phases.                                                      *
+ ****************************************************************/
+/* Reads the input in chunks of capacity elements, sorts them and
+   writes each one as a run. Returns 1 on success, 0 otherwise. */
+static int writeRuns(Reader *reader, int input, off_t size, long capacity,
+        const char *directory, Array_Run *runs) {
+    Stream stream;
+    Run run;
+    int *data, *scratch;
+    long n;
+    int ok = 1;
+
+    if (!(scratch = (int *) malloc(sizeof(int) * capacity))) {
+        return 0;
+    }
+    if (!openStream(reader, &stream, input, 0, size, capacity)) {
+        free(scratch);
+        return 0;
+    }
+
+    /* The chunk is sorted in its block, which stays with this thread
+       until the next one is taken. */
+    while (ok && (n = nextBlock(reader, &stream, &data)) != 0) {
+        ok = n > 0 && createRun(directory, &run);
+        if (ok) {
+            radixSort(data, scratch, n);
+            run.n = n;
+            ok = writeAll(run.fd, data, sizeof(int) * n) && insertArray_Run(runs, run);
+            if (!ok) {
+                close(run.fd);
+            }
+        }
+    }
+
+    closeStream(reader, &stream);
+    free(scratch);
+
+    return ok;
+}
+
+/* Merges k runs into the file output, using blocks that fit in the
+   given memory. Writes the number of elements merged in written.
+   Returns 1 on success, 0 otherwise. */
+static int mergeRuns(Reader *reader, Run *runs, int k, int output, size_t memory, long *written) {
+    Heap_int_int heap;
+    Stream *streams;
+    int **data, *buffer;
+    long *n, *position, capacity, length = 0;
+    int opened, ok = 1, r;
+
+    capacity = memory / sizeof(int) / (2 * k + 1);
+    if (capacity < MIN_BLOCK) {
+        capacity = MIN_BLOCK;
+    }
+
+    *written = 0;
+    streams = (Stream *) malloc(sizeof(Stream) * k);
+    data = (int **) malloc(sizeof(int *) * k);
+    n = (long *) malloc(sizeof(long) * k);
+    position = (long *) malloc(sizeof(long) * k);
+    buffer = (int *) malloc(sizeof(int) * capacity);
+    if (!streams || !data || !n || !position || !buffer || !createHeap_int_int(&heap, k)) {
+        free(streams);
+        free(data);
+        free(n);
+        free(position);
+        free(buffer);
+        return 0;
+    }
+
+    /* Starts reading all runs before waiting for any of them. */
+    for (opened = 0; opened < k; opened++) {
+        if (!openStream(reader, &streams[opened], runs[opened].fd, 0,
+                sizeof(int) * runs[opened].n, capacity)) {
+            ok = 0;
+            break;
+        }
+    }
+
+    for (r = 0; ok && r < k; r++) {
+        n[r] = nextBlock(reader, &streams[r], &data[r]);
+        position[r] = 0;
+        ok = n[r] >= 0;
+        if (n[r] > 0) {
+            insertHeap_int_int(&heap, data[r][0], r);
+        }
+    }
+
+    /* The top is replaced by the next element of its run, and only
+       sinks from the root, instead of being extracted and inserted. */
+    while (ok && heap.n > 0) {
+        buffer[length++] = heap.keys[1];
+        if (length == capacity) {
+            ok = writeAll(output, buffer, sizeof(int) * length);
+            *written += length;
+            length = 0;
+        }
+
+        r = heap.values[1];
+        if (++position[r] == n[r]) {
+            n[r] = nextBlock(reader, &streams[r], &data[r]);
+            position[r] = 0;
+            ok = ok && n[r] >= 0;
+        }
+
+        if (n[r] > 0) {
+            heap.keys[1] = data[r][position[r]];
+            fixDownHeap_int_int(&heap, 1);
+        }
+        else {
+            removeHeapAt_int_int(&heap, 1, NULL, NULL);
+        }
+    }
+
+    if (ok && length > 0) {
+        ok = writeAll(output, buffer, sizeof(int) * length);
+        *written += length;
+    }
+
+    for (r = 0; r < opened; r++) {
+        closeStream(reader, &streams[r]);
+    }
+    freeHeap_int_int(&heap);
+    free(streams);
+    free(data);
+    free(n);
+    free(position);
+    free(buffer);
+
+    return ok;
+}
+
+/* Merges runs in groups of at most fanIn into longer runs, until
+   there are fanIn runs or less. Returns 1 on success, 0 otherwise,
+   and in both cases runs holds the runs left open. */
+static int mergeGroups(Reader *reader, Array_Run *runs, int fanIn, size_t memory,
+        const char *directory, SortStats *stats) {
+    Array_Run merged;
+    Run run;
+    int first, k, ok = 1;
+
+    while (ok && runs->n > fanIn) {
+        if (!createArray_Run(&merged, runs->n / fanIn + 1)) {
+            return 0;
+        }
+
+        for (first = 0; ok && first < runs->n; first += k) {
+            k = runs->n - first < fanIn ? runs->n - first : fanIn;
+
+            if (k == 1) {
+                ok = insertArray_Run(&merged, runs->info[first]);
+            }
+            else if ((ok = createRun(directory, &run))) {
+                ok = mergeRuns(reader, runs->info + first, k, run.fd, memory, &run.n)
+                    && insertArray_Run(&merged, run);
+                if (!ok) {
+                    close(run.fd);
+                }
+                else {
+                    closeRuns(runs, first, first + k);
+                }
+            }
+        }
+
+        /* Keeps whichever runs are still open after a failure. */
+        if (!ok) {
+            closeRuns(&merged, 0, merged.n);
+            closeRuns(runs, first - k, runs->n);
+            runs->n = 0;
+            freeArray_Run(&merged);
+            return 0;
+        }
+
+        freeArray_Run(runs);
+        *runs = merged;
+        stats->passes++;
+    }
+
+    return ok;
+}
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+/* Sorts the ints of the file input into the file output, using about
+   memory bytes for buffers and writing the runs to directory. Fills
+   stats, if given. Returns 1 on success, 0 otherwise. */
+int externalSort(const char *input, const char *output, size_t memory,
+        const char *directory, SortStats *stats) {
+    SortStats s;
+    Reader reader;
+    Array_Run runs;
+    struct stat status;
+    long capacity;
+    double start;
+    int in, out, fanIn, ok;
+
+    memset(&s, 0, sizeof(s));
+    if ((in = open(input, O_RDONLY)) < 0) {
+        return 0;
+    }
+    if (fstat(in, &status) < 0 || status.st_size % sizeof(int) != 0) {
+        close(in);
+        return 0;
+    }
+    if ((out = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+        close(in);
+        return 0;
+    }
+    if (!createArray_Run(&runs, 16)) {
+        close(out);
+        close(in);
+        return 0;
+    }
+    if (!startReader(&reader)) {
+        freeArray_Run(&runs);
+        close(out);
+        close(in);
+        return 0;
+    }
+
+    /* The two blocks being read and sorted, and the sort buffer. */
+    capacity = memory / sizeof(int) / 3;
+    if (capacity < MIN_BLOCK) {
+        capacity = MIN_BLOCK;
+    }
+    fanIn = (memory / sizeof(int) / MIN_BLOCK - 1) / 2;
+    if (fanIn < 2) {
+        fanIn = 2;
+    }
+
+    start = now();
+    ok = writeRuns(&reader, in, status.st_size, capacity, directory, &runs);
+    s.runSeconds = now() - start;
+    s.runs = runs.n;
+
+    start = now();
+    ok = ok && mergeGroups(&reader, &runs, fanIn, memory, directory, &s);
+    if (ok && runs.n > 0) {
+        ok = mergeRuns(&reader, runs.info, runs.n, out, memory, &s.n);
+        s.passes++;
+    }
+    s.mergeSeconds = now() - start;
+
+    stopReader(&reader);
+    s.waitSeconds = reader.waitSeconds;
+
+    closeRuns(&runs, 0, runs.n);
+    freeArray_Run(&runs);
+    ok = close(out) == 0 && ok;
+    close(in);
+
+    if (stats) {
+        *stats = s;
+    }
+
+    return ok;
+}
@@ -0,0 +1,32 @@
+#ifndef EXTERNALSORT_H
+#define EXTERNALSORT_H
+
+#include <stddef.h>
+
+/*****************************************************************
+ *  Settings.                                                    *
+ ****************************************************************/
+/* Smallest block read or written at once, in elements (64 KiB).
+   Smaller blocks make the disk seek more than it transfers. */
+#define MIN_BLOCK (16 * 1024)
+
+/*****************************************************************
+ *  Definition of statistics.                                    *
+ ****************************************************************/
+/* What a sort did, and how long each phase took. */
+typedef struct {
+    long n; /* Elements sorted. */
+    int runs; /* Sorted runs written by the first phase. */
+    int passes; /* Merge passes, counting the last one into the output. */
+    double runSeconds; /* Reading, sorting and writing the runs. */
+    double mergeSeconds; /* Merging the runs into the output. */
+    double waitSeconds; /* Time spent waiting for reads, in both phases. */
+} SortStats;
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+int externalSort(const char *input, const char *output, size_t memory,
+    const char *directory, SortStats *stats);
+
+#endif /* EXTERNALSORT_H */
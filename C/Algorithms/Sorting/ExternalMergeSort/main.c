@@ -0,0 +1,194 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "externalsort.h"
+
+/*****************************************************************
+ *  Settings.                                                    *
+ ****************************************************************/
+#define DEFAULT_MEMORY 64 /* MiB of buffers. */
+#define IO_BUFFER (256 * 1024) /* Ints generated or checked at once. */
+
+/*****************************************************************
+ *  Auxiliary functions.                                         *
+ ****************************************************************/
+/* Prints the command line options. */
+void usage(char *program) {
+    fprintf(stderr, "Usage: %s [-m memory_mib] [-t directory] [-g count] [-d seed] [-c]\n"
+        "          input output\n"
+        "  -m  memory for the buffers, in MiB (default %d)\n"
+        "  -t  directory of the temporary runs (default $TMPDIR, or /tmp)\n"
+        "  -g  first writes this many random ints to input\n"
+        "  -d  seed of the random ints (default 1)\n"
+        "  -c  checks that output is sorted and holds the elements of input\n"
+        "Files hold ints in the native format of the machine.\n",
+        program, DEFAULT_MEMORY);
+}
+
+/* Returns the next random number of a xorshift generator. */
+static uint64_t nextRandom(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/* Writes count random ints to path. Returns 1 on success, 0 otherwise. */
+static int generate(const char *path, long count, uint64_t seed) {
+    int *buffer;
+    FILE *file;
+    long i, n;
+    int ok = 1;
+
+    if (!(file = fopen(path, "wb"))) {
+        return 0;
+    }
+    if (!(buffer = (int *) malloc(sizeof(int) * IO_BUFFER))) {
+        fclose(file);
+        return 0;
+    }
+
+    seed = seed ? seed : 1;
+    for (i = 0; ok && i < count; i += n) {
+        for (n = 0; n < IO_BUFFER && i + n < count; n++) {
+            buffer[n] = (int) (nextRandom(&seed) >> 32);
+        }
+        ok = fwrite(buffer, sizeof(int), n, file) == (size_t) n;
+    }
+
+    free(buffer);
+    return fclose(file) == 0 && ok;
+}
+
+/* Summary of a file of ints, independent of their order. */
+typedef struct {
+    long n;
+    uint64_t sum, sumOfSquares;
+    int sorted;
+} Summary;
+
+/* Reads path and summarizes its elements. Returns 1 on success. */
+static int summarize(const char *path, Summary *summary) {
+    int *buffer, previous = 0;
+    FILE *file;
+    size_t n, i;
+
+    summary->n = 0;
+    summary->sum = summary->sumOfSquares = 0;
+    summary->sorted = 1;
+
+    if (!(file = fopen(path, "rb"))) {
+        return 0;
+    }
+    if (!(buffer = (int *) malloc(sizeof(int) * IO_BUFFER))) {
+        fclose(file);
+        return 0;
+    }
+
+    while ((n = fread(buffer, sizeof(int), IO_BUFFER, file)) > 0) {
+        for (i = 0; i < n; i++) {
+            if (summary->n + i > 0 && buffer[i] < previous) {
+                summary->sorted = 0;
+            }
+            previous = buffer[i];
+            summary->sum += (uint64_t) buffer[i];
+            summary->sumOfSquares += (uint64_t) buffer[i] * (uint64_t) buffer[i];
+        }
+        summary->n += n;
+    }
+
+    free(buffer);
+    fclose(file);
+    return 1;
+}
+
+/* Prints the time and throughput of a phase that went through bytes. */
+static void printPhase(const char *phase, double bytes, double seconds) {
+    printf("%-6s %8.2f s %10.1f MB/s\n", phase, seconds, seconds > 0 ? bytes / 1e6 / seconds : 0);
+}
+
+/*****************************************************************
+ *  Main function.                                               *
+ ****************************************************************/
+int main(int argc, char **argv) {
+    const char *directory = getenv("TMPDIR");
+    long memory = DEFAULT_MEMORY, count = -1;
+    uint64_t seed = 1;
+    Summary before, after;
+    SortStats stats;
+    double bytes;
+    int check = 0, opt;
+
+    while ((opt = getopt(argc, argv, "m:t:g:d:c")) != -1) {
+        switch (opt) {
+            case 'm':
+                memory = atol(optarg);
+                break;
+            case 't':
+                directory = optarg;
+                break;
+            case 'g':
+                count = atol(optarg);
+                break;
+            case 'd':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'c':
+                check = 1;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (argc - optind != 2 || memory < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (!directory) {
+        directory = "/tmp";
+    }
+
+    if (count >= 0 && !generate(argv[optind], count, seed)) {
+        fprintf(stderr, "Could not write %s.\n", argv[optind]);
+        return 1;
+    }
+
+    if (!externalSort(argv[optind], argv[optind + 1], (size_t) memory << 20, directory, &stats)) {
+        fprintf(stderr, "Could not sort %s into %s.\n", argv[optind], argv[optind + 1]);
+        return 1;
+    }
+
+    bytes = (double) stats.n * sizeof(int);
+    printf("Sorted %ld ints (%.1f MB) with %ld MiB: %d runs, %d merge passes.\n",
+        stats.n, bytes / 1e6, memory, stats.runs, stats.passes);
+    printPhase("Runs:", bytes, stats.runSeconds);
+    printPhase("Merge:", bytes * stats.passes, stats.mergeSeconds);
+    printPhase("Total:", bytes, stats.runSeconds + stats.mergeSeconds);
+    printf("Waited %.2f s for reads.\n", stats.waitSeconds);
+
+    if (check) {
+        if (!summarize(argv[optind], &before) || !summarize(argv[optind + 1], &after)) {
+            fprintf(stderr, "Could not read the files back.\n");
+            return 1;
+        }
+        if (!after.sorted || after.n != before.n || after.sum != before.sum
+                || after.sumOfSquares != before.sumOfSquares) {
+            printf("Check failed: the output is %s and %s the elements of the input.\n",
+                after.sorted ? "sorted" : "not sorted",
+                after.n == before.n && after.sum == before.sum
+                    && after.sumOfSquares == before.sumOfSquares ? "holds" : "does not hold");
+            return 1;
+        }
+        printf("Check passed.\n");
+    }
+
+    return 0;
+}
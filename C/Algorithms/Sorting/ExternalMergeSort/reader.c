@@ -0,0 +1,206 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "reader.h"
+
+/*****************************************************************
+ *  Auxiliary functions.                                         *
+ ****************************************************************/
+/* Returns the current time, in seconds. */
+static double now() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Reads size bytes at offset, retrying short reads. Returns 1 on
+   success, 0 on errors or if the file ends before. */
+static int readAll(int fd, void *buffer, size_t size, off_t offset) {
+    char *p = (char *) buffer;
+    ssize_t bytes;
+
+    while (size > 0) {
+        if ((bytes = pread(fd, p, size, offset)) <= 0) {
+            return 0;
+        }
+
+        p += bytes;
+        offset += bytes;
+        size -= bytes;
+    }
+
+    return 1;
+}
+
+/* Queues the read of the next elements of a stream into one of its
+   blocks. Must be called with the lock of the reader held. */
+static void requestBlock(Reader *reader, Stream *stream, Block *block) {
+    long remaining = (stream->end - stream->offset) / sizeof(int);
+
+    block->n = remaining < stream->capacity ? remaining : stream->capacity;
+    block->offset = stream->offset;
+    stream->offset += block->n * sizeof(int);
+
+    /* After the end, the block is ready at once, with no elements. */
+    if (block->n == 0) {
+        block->ready = 1;
+        return;
+    }
+
+    block->ready = 0;
+    listInsertEnd(&reader->pending, &block->link);
+    pthread_cond_signal(&reader->requested);
+}
+
+/*****************************************************************
+ *  Reader thread.                                               *
+ ****************************************************************/
+/* Serves the queued reads in order, until the reader is stopped. */
+static void *readBlocks(void *arg) {
+    Reader *reader = (Reader *) arg;
+    Block *block;
+    int ok;
+
+    pthread_mutex_lock(&reader->lock);
+    for (;;) {
+        while (listEmpty(&reader->pending) && !reader->stopping) {
+            pthread_cond_wait(&reader->requested, &reader->lock);
+        }
+        if (listEmpty(&reader->pending)) {
+            break;
+        }
+
+        block = container_of(reader->pending.next, Block, link);
+        listUnlink(&block->link);
+
+        /* Only this thread touches a queued block, so it is filled
+           without the lock. */
+        pthread_mutex_unlock(&reader->lock);
+        ok = readAll(block->stream->fd, block->data, block->n * sizeof(int), block->offset);
+        pthread_mutex_lock(&reader->lock);
+
+        if (!ok) {
+            block->n = -1;
+        }
+        block->ready = 1;
+        pthread_cond_broadcast(&reader->completed);
+    }
+    pthread_mutex_unlock(&reader->lock);
+
+    return NULL;
+}
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+/* Starts the reader thread. Returns 1 on success, 0 otherwise. */
+int startReader(Reader *reader) {
+    pthread_mutex_init(&reader->lock, NULL);
+    pthread_cond_init(&reader->requested, NULL);
+    pthread_cond_init(&reader->completed, NULL);
+    listInit(&reader->pending);
+    reader->stopping = 0;
+    reader->waitSeconds = 0;
+
+    if (pthread_create(&reader->thread, NULL, readBlocks, reader) != 0) {
+        pthread_cond_destroy(&reader->completed);
+        pthread_cond_destroy(&reader->requested);
+        pthread_mutex_destroy(&reader->lock);
+        return 0;
+    }
+
+    return 1;
+}
+
+/* Stops the reader thread, after it serves the reads already queued. */
+void stopReader(Reader *reader) {
+    pthread_mutex_lock(&reader->lock);
+    reader->stopping = 1;
+    pthread_cond_signal(&reader->requested);
+    pthread_mutex_unlock(&reader->lock);
+
+    pthread_join(reader->thread, NULL);
+    pthread_cond_destroy(&reader->completed);
+    pthread_cond_destroy(&reader->requested);
+    pthread_mutex_destroy(&reader->lock);
+}
+
+/* Opens a stream over the bytes of fd from offset to end, read in
+   blocks of capacity elements, and starts reading its first two
+   blocks. Returns 1 on success, 0 otherwise. */
+int openStream(Reader *reader, Stream *stream, int fd, off_t offset, off_t end, long capacity) {
+    int i;
+
+    stream->fd = fd;
+    stream->offset = offset;
+    stream->end = end;
+    stream->capacity = capacity;
+    stream->current = -1;
+
+    for (i = 0; i < 2; i++) {
+        stream->blocks[i].stream = stream;
+        if (!(stream->blocks[i].data = (int *) malloc(sizeof(int) * capacity))) {
+            if (i > 0) {
+                free(stream->blocks[0].data);
+            }
+            return 0;
+        }
+    }
+
+    pthread_mutex_lock(&reader->lock);
+    requestBlock(reader, stream, &stream->blocks[0]);
+    requestBlock(reader, stream, &stream->blocks[1]);
+    pthread_mutex_unlock(&reader->lock);
+
+    return 1;
+}
+
+/* Hands the next block of a stream to the consumer, waiting for its
+   read if needed, and queues the read of the following elements into
+   the block handed before, which must not be used anymore. Points
+   data to the elements and returns how many there are: 0 at the end
+   of the stream and -1 if the read failed. */
+long nextBlock(Reader *reader, Stream *stream, int **data) {
+    Block *block;
+    double start;
+    long n;
+
+    pthread_mutex_lock(&reader->lock);
+    if (stream->current >= 0) {
+        requestBlock(reader, stream, &stream->blocks[stream->current]);
+    }
+    stream->current = stream->current == 0 ? 1 : 0;
+    block = &stream->blocks[stream->current];
+
+    if (!block->ready) {
+        start = now();
+        while (!block->ready) {
+            pthread_cond_wait(&reader->completed, &reader->lock);
+        }
+        reader->waitSeconds += now() - start;
+    }
+    n = block->n;
+    pthread_mutex_unlock(&reader->lock);
+
+    *data = block->data;
+    return n;
+}
+
+/* Waits for the reads of a stream that are still queued, and frees
+   its blocks. */
+void closeStream(Reader *reader, Stream *stream) {
+    pthread_mutex_lock(&reader->lock);
+    while (!stream->blocks[0].ready || !stream->blocks[1].ready) {
+        pthread_cond_wait(&reader->completed, &reader->lock);
+    }
+    pthread_mutex_unlock(&reader->lock);
+
+    free(stream->blocks[0].data);
+    free(stream->blocks[1].data);
+}
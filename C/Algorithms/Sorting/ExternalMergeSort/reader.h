@@ -0,0 +1,57 @@
+#ifndef READER_H
+#define READER_H
+
+#include <pthread.h>
+#include <sys/types.h>
+
+#include "../../../DataStructures/LinkedLists/IntrusiveLinkedLists/IntrusiveLinkedList.h"
+
+/*****************************************************************
+ *  Double-buffered reads.                                       *
+ *                                                               *
+ *  A stream reads a region of a file, block by block, into two  *
+ *  buffers. While the consumer works on one of them, a reader   *
+ *  thread shared by all streams fills the other one, so reading *
+ *  overlaps with sorting and merging. Reads are served in the   *
+ *  order they are requested.                                    *
+ ****************************************************************/
+struct stream;
+
+/* Buffer of a stream. */
+typedef struct {
+    int *data;
+    long n; /* Elements read, 0 after the end and -1 after an error. */
+    off_t offset; /* Where the elements come from in the file. */
+    int ready; /* Whether the read is over. */
+    struct stream *stream;
+    ListLink link; /* Place in the queue of reads. */
+} Block;
+
+typedef struct stream {
+    int fd;
+    off_t offset, end; /* Next byte to request, and end of the region. */
+    long capacity; /* Elements in each block. */
+    Block blocks[2];
+    int current; /* Block being consumed, -1 before the first one. */
+} Stream;
+
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t requested; /* Signaled when a read is queued. */
+    pthread_cond_t completed; /* Signaled when a read is over. */
+    ListLink pending; /* Blocks waiting to be read. */
+    int stopping;
+    double waitSeconds; /* Time consumers waited for reads. */
+} Reader;
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+int startReader(Reader *reader);
+void stopReader(Reader *reader);
+int openStream(Reader *reader, Stream *stream, int fd, off_t offset, off_t end, long capacity);
+long nextBlock(Reader *reader, Stream *stream, int **data);
+void closeStream(Reader *reader, Stream *stream);
+
+#endif /* READER_H */
@@ -0,0 +1,241 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "sync.h"
+#include "reindeer.h"
+#include "elf.h"
+#include "workshop.h"
+#include "sim.h"
+
+/*****************************************************************
+ *  Global variables initialization.                             *
+ ****************************************************************/
+int headless = 0;
+atomic_int stop;
+
+/* Random stream of each thread, seeded when first used. */
+static __thread Rng threadRng;
+
+/* Resource usage when the simulation started. */
+static struct rusage startUsage;
+
+/*****************************************************************
+ *  Time and pauses.                                             *
+ ****************************************************************/
+/* Returns a monotonic timestamp in nanoseconds. */
+long wallNs() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/* Returns the time of the simulation in nanoseconds. In deterministic
+   mode, it is the simulated time. */
+long nowNs() {
+    return simulated ? simNow() : wallNs();
+}
+
+/* Pauses the calling thread for a random amount of seconds, below
+   the given maximum. Headless runs never pause, unless they are
+   deterministic, where pauses only advance the simulated clock. */
+void nap(int maxSeconds) {
+    if (simulated) {
+        simSleep((nextRng(simRng()) % maxSeconds) * 1000000000L);
+    }
+    else if (!headless) {
+        if (!threadRng.state) {
+            seedRng(&threadRng, (unsigned long) wallNs() ^ (unsigned long) &threadRng);
+        }
+
+        sleep(nextRng(&threadRng) % maxSeconds);
+    }
+}
+
+/* Tells whether the simulation is finishing. Threads check it after
+   every wait, since they are released by extra posts to leave. */
+int stopping() {
+    return atomic_load_explicit(&stop, memory_order_acquire);
+}
+
+/*****************************************************************
+ *  Latency histograms.                                          *
+ ****************************************************************/
+/* Returns the bucket of a value. */
+static int bucketOf(unsigned long v) {
+    int msb;
+
+    if (v < 16) {
+        return (int) v;
+    }
+
+    msb = 63 - __builtin_clzl(v);
+
+    return 16 + (msb - 4) * 8 + (int) ((v >> (msb - 3)) & 7);
+}
+
+/* Returns the smallest value of a bucket. */
+static unsigned long bucketValue(int b) {
+    int msb;
+
+    if (b < 16) {
+        return b;
+    }
+
+    msb = (b - 16) / 8 + 4;
+
+    return (8UL + (b - 16) % 8) << (msb - 3);
+}
+
+/* Adds a sample to the histogram. Safe to call from any thread. */
+void recordLatency(Histogram *histogram, long ns) {
+    long max;
+    int b;
+
+    if (ns < 0) {
+        ns = 0;
+    }
+
+    b = bucketOf(ns);
+    if (b >= HISTOGRAM_BUCKETS) {
+        b = HISTOGRAM_BUCKETS - 1;
+    }
+
+    atomic_fetch_add_explicit(&histogram->buckets[b], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->count, 1, memory_order_relaxed);
+
+    max = atomic_load_explicit(&histogram->max, memory_order_relaxed);
+    while (ns > max && !atomic_compare_exchange_weak(&histogram->max, &max, ns));
+}
+
+/* Returns the value below which the fraction p of the samples lie. */
+long percentile(Histogram *histogram, double p) {
+    unsigned long count, seen, target;
+    int b;
+
+    count = atomic_load(&histogram->count);
+    if (count == 0) {
+        return 0;
+    }
+
+    target = (unsigned long) ceil(p * count);
+    seen = 0;
+    for (b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        seen += atomic_load(&histogram->buckets[b]);
+
+        if (seen >= target) {
+            return bucketValue(b);
+        }
+    }
+
+    return atomic_load(&histogram->max);
+}
+
+/*****************************************************************
+ *  Report.                                                      *
+ ****************************************************************/
+/* Takes the resource usage the report is relative to. */
+void startStatistics() {
+    getrusage(RUSAGE_SELF, &startUsage);
+}
+
+/* Prints a latency histogram summary. */
+static void printLatency(const char *name, Histogram *histogram) {
+    printf("%s latency ns: p50 %ld p90 %ld p99 %ld p99.9 %ld max %ld (%lu samples)\n", name,
+        percentile(histogram, 0.5), percentile(histogram, 0.9),
+        percentile(histogram, 0.99), percentile(histogram, 0.999),
+        atomic_load(&histogram->max), atomic_load(&histogram->count));
+}
+
+/* Adds the samples of a histogram to another one. */
+static void mergeHistogram(Histogram *into, Histogram *from) {
+    long max;
+    int b;
+
+    for (b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        atomic_fetch_add(&into->buckets[b], atomic_load(&from->buckets[b]));
+    }
+    atomic_fetch_add(&into->count, atomic_load(&from->count));
+
+    max = atomic_load(&from->max);
+    if (max > atomic_load(&into->max)) {
+        atomic_store(&into->max, max);
+    }
+}
+
+/* Prints throughput, latency and fairness statistics of a run, over
+   all workshops. */
+void printReport(SantaWorkshop *workshops, int n, double elapsed) {
+    static Histogram santaWakeup, elfWakeup, reindeerWakeup;
+    struct rusage usage;
+    double sum, sumSquares, mean;
+    long elfGroupsHelped, sleighLaunches, wakeups;
+    int i, j, min, max, helps, nElves;
+
+    elfGroupsHelped = sleighLaunches = 0;
+    for (i = 0; i < n; i++) {
+        elfGroupsHelped += workshops[i].elfGroupsHelped;
+        sleighLaunches += workshops[i].sleighLaunches;
+        mergeHistogram(&santaWakeup, &workshops[i].santaWakeup);
+        mergeHistogram(&elfWakeup, &workshops[i].elfWakeup);
+        mergeHistogram(&reindeerWakeup, &workshops[i].reindeerWakeup);
+    }
+
+    printf("backend: %s\n", syncBackendName());
+    printf("workshops: %d\n", n);
+    printf("elves: %d\n", N_ELVES);
+    printf("reindeer: %d\n", N_REINDEER);
+    printf("group size: %d\n", ELVES_GROUP_SIZE);
+    printf("elapsed s: %.3f\n", elapsed);
+    if (simulated) {
+        printf("seed: %lu\n", simSeed);
+        printf("simulated s: %.3f\n", simNow() / 1e9);
+        printf("coroutine switches: %ld\n", simSwitches());
+        printf("event digest: %016lx\n", simEventDigest());
+    }
+    printf("elf groups helped: %ld\n", elfGroupsHelped);
+    printf("sleigh launches: %ld\n", sleighLaunches);
+    printf("elf groups/s: %.1f\n", elfGroupsHelped / elapsed);
+    printf("sleigh launches/s: %.1f\n", sleighLaunches / elapsed);
+
+    printLatency("santa wakeup", &santaWakeup);
+    printLatency("elf wakeup", &elfWakeup);
+    printLatency("reindeer wakeup", &reindeerWakeup);
+
+    /* Context switches of all threads, per time Santa woke up. */
+    getrusage(RUSAGE_SELF, &usage);
+    wakeups = elfGroupsHelped + sleighLaunches > 0 ? elfGroupsHelped + sleighLaunches : 1;
+    printf("context switches per round: voluntary %.1f involuntary %.1f\n",
+        (double) (usage.ru_nvcsw - startUsage.ru_nvcsw) / wakeups,
+        (double) (usage.ru_nivcsw - startUsage.ru_nivcsw) / wakeups);
+
+    /* Fairness among elves of all workshops. Jain's index is 1 when all
+       of them got help the same number of times and 1/n in the worst case. */
+    sum = sumSquares = 0;
+    min = max = workshops[0].elfHelps[0];
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < N_ELVES; j++) {
+            helps = workshops[i].elfHelps[j];
+            sum += helps;
+            sumSquares += (double) helps * helps;
+            min = helps < min ? helps : min;
+            max = helps > max ? helps : max;
+        }
+    }
+    nElves = n * N_ELVES;
+    mean = sum / nElves;
+
+    printf("helps per elf: min %d max %d mean %.1f stddev %.1f jain %.4f\n", min, max, mean,
+        sqrt(fmax(0, sumSquares / nElves - mean * mean)),
+        sumSquares > 0 ? sum * sum / (nElves * sumSquares) : 1.0);
+}
@@ -0,0 +1,39 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdatomic.h>
+
+/*****************************************************************
+ *  Definition of latency histograms.                            *
+ ****************************************************************/
+/* Values below 16ns get one bucket each. Above that, each power
+   of 2 is split in 8 buckets, so percentiles are within 12.5%. */
+#define HISTOGRAM_BUCKETS 320
+
+typedef struct {
+    atomic_ulong buckets[HISTOGRAM_BUCKETS];
+    atomic_ulong count;
+    atomic_long max;
+} Histogram;
+
+/*****************************************************************
+ *  Global variables.                                            *
+ ****************************************************************/
+extern int headless; /* No output and no pauses between actions. */
+extern atomic_int stop; /* Set when all threads must finish. */
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+long wallNs();
+long nowNs();
+void startStatistics();
+void nap(int maxSeconds);
+int stopping();
+void recordLatency(Histogram *histogram, long ns);
+long percentile(Histogram *histogram, double p);
+struct santaWorkshop;
+
+void printReport(struct santaWorkshop *workshops, int n, double elapsed);
+
+#endif /* BENCH_H */
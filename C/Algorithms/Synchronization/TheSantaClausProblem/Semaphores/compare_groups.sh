@@ -0,0 +1,34 @@
+#!/bin/sh
+# Runs the headless benchmark with growing group sizes and prints a
+# Markdown table of how wakeup latencies and context switches change
+# with each synchronization backend. Each group size G runs with G
+# reindeer and 4G elves in groups of G, for SECONDS seconds.
+#
+# Usage: ./compare_groups.sh [seconds] > GROUPS_REPORT.md
+
+SECONDS_PER_RUN=${1:-2}
+BACKENDS="sem condvar futex spin"
+GROUP_SIZES="2 8 32 128"
+
+echo "# Group release comparison"
+echo
+echo "Generated by \`compare_groups.sh $SECONDS_PER_RUN\` on $(uname -srm), $(nproc) CPU(s)."
+echo "Latencies are in microseconds. Context switches are counted for the whole process, per time Santa woke up."
+echo
+echo "| group | backend | elf groups/s | sleigh launches/s | elf wakeup p50 | p99 | reindeer wakeup p50 | p99 | voluntary switches/round | involuntary |"
+echo "|---|---|---|---|---|---|---|---|---|---|"
+
+for g in $GROUP_SIZES; do
+    for backend in $BACKENDS; do
+        ./main -H -e $((4 * g)) -r "$g" -g "$g" -t "$SECONDS_PER_RUN" -s "$backend" | awk -v g="$g" -v b="$backend" '
+            /^elf groups\/s:/ { groups = $3 }
+            /^sleigh launches\/s:/ { launches = $3 }
+            /^elf wakeup latency/ { e50 = $6 / 1000; e99 = $10 / 1000 }
+            /^reindeer wakeup latency/ { r50 = $6 / 1000; r99 = $10 / 1000 }
+            /^context switches per round:/ { voluntary = $6; involuntary = $8 }
+            END {
+                printf "| %s | %s | %s | %s | %.1f | %.1f | %.1f | %.1f | %s | %s |\n",
+                    g, b, groups, launches, e50, e99, r50, r99, voluntary, involuntary
+            }'
+    done
+done
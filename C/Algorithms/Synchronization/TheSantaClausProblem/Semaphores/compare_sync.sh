@@ -0,0 +1,38 @@
+#!/bin/sh
+# Runs the headless benchmark with every synchronization backend and
+# prints a Markdown comparison table. Each configuration is given as
+# "elves reindeer group_size" and runs for SECONDS seconds.
+#
+# Usage: ./compare_sync.sh [seconds] > SYNC_REPORT.md
+
+SECONDS_PER_RUN=${1:-2}
+BACKENDS="sem condvar futex spin"
+CONFIGS="15:9:3 200:30:5 1000:100:10"
+
+echo "# Synchronization backends comparison"
+echo
+echo "Generated by \`compare_sync.sh $SECONDS_PER_RUN\` on $(uname -srm), $(nproc) CPU(s)."
+echo "Latencies are in microseconds."
+echo
+echo "| elves | reindeer | group | backend | elf groups/s | sleigh launches/s | Santa wakeup p50 | p99 | elf wakeup p50 | p99 | reindeer wakeup p50 | p99 | Jain |"
+echo "|---|---|---|---|---|---|---|---|---|---|---|---|---|"
+
+for config in $CONFIGS; do
+    e=$(echo "$config" | cut -d: -f1)
+    r=$(echo "$config" | cut -d: -f2)
+    g=$(echo "$config" | cut -d: -f3)
+
+    for backend in $BACKENDS; do
+        ./main -H -e "$e" -r "$r" -g "$g" -t "$SECONDS_PER_RUN" -s "$backend" | awk -v e="$e" -v r="$r" -v g="$g" -v b="$backend" '
+            /^elf groups\/s:/ { groups = $3 }
+            /^sleigh launches\/s:/ { launches = $3 }
+            /^santa wakeup latency/ { s50 = $6 / 1000; s99 = $10 / 1000 }
+            /^elf wakeup latency/ { e50 = $6 / 1000; e99 = $10 / 1000 }
+            /^reindeer wakeup latency/ { r50 = $6 / 1000; r99 = $10 / 1000 }
+            /^helps per elf:/ { jain = $13 }
+            END {
+                printf "| %s | %s | %s | %s | %s | %s | %.1f | %.1f | %.1f | %.1f | %.1f | %.1f | %s |\n",
+                    e, r, g, b, groups, launches, s50, s99, e50, e99, r50, r99, jain
+            }'
+    done
+done
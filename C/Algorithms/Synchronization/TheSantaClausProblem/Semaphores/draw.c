@@ -2,10 +2,11 @@
  *  Libraries import.                                            *
  ****************************************************************/
 #include <pthread.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
-#include <semaphore.h>
 
 #include "draw.h"
 #include "reindeer.h"
@@ -14,68 +15,307 @@
 /*****************************************************************
  *  Global variables initialization.                             *
  ****************************************************************/
-/* States used for output. */
-extern SantaState santaState;
-extern ElfState *elvesStates;
-extern ReindeerState *reindeerStates;
-extern Action action;
-extern int reindeerThatArrived;
-extern int reindeerThatWasAttached;
-extern int reindeerWantToBeAttended;
-extern int elfThatGotHelp;
-extern int elfThatArrivedAtTheDoor;
-extern int elfThatHadProblems;
-extern int elvesWantToBeAttented;
-
-/* Semaphores. */
-extern sem_t lockWrite;
+/* States used for output. They are only touched by the renderer
+   thread, which rebuilds them from the logged events. */
+static SantaState santaState = SLEEPING;
+static ElfState *elvesStates;
+static ReindeerState *reindeerStates;
+static Action action;
+static int reindeerThatArrived;
+static int reindeerThatWasAttached;
+static int reindeerWantToBeAttended = 0;
+static int elfThatGotHelp;
+static int elfThatArrivedAtTheDoor;
+static int elfThatHadProblems;
+static int elvesWantToBeAttented = 0;
+
+/*****************************************************************
+ *  Frames.                                                      *
+ *                                                               *
+ *  Each frame is composed into a grid of characters and only    *
+ *  the parts of each row that changed since the previous frame  *
+ *  are sent to the terminal, with ANSI cursor addressing, in a  *
+ *  single write.                                                *
+ ****************************************************************/
+#define FRAME_WIDTH 128 /* Characters beyond it are not drawn. */
+
+static char *frame; /* Frame being composed. */
+static char *shown; /* Frame on the terminal. */
+static int *frameLengths, *shownLengths; /* Characters used in each row. */
+static int frameRows;
+static int row, column; /* Where the next character of the frame goes. */
+static int rowsShown; /* Rows used by any frame so far, 0 before the first. */
+
+/* Escape sequences of a whole frame, written at once. */
+static char *out;
+static size_t outLength;
+
+/*****************************************************************
+ *  Output states management.                                    *
+ ****************************************************************/
+/* Allocates the elves' and reindeer's states. Returns 1 on success. */
+int initOutput() {
+    int i;
+
+    /* Rows of the lists of elves and reindeer (7 per row), Santa and
+       the list of elves waiting (5 per row), with blank lines among them. */
+    frameRows = (N_ELVES + 6) / 7 + (N_REINDEER + 6) / 7 + (N_ELVES + 4) / 5 + 16;
+
+    reindeerStates = (ReindeerState *) malloc(sizeof(ReindeerState) * N_REINDEER);
+    elvesStates = (ElfState *) malloc(sizeof(ElfState) * N_ELVES);
+    frame = (char *) malloc(FRAME_WIDTH * frameRows);
+    shown = (char *) malloc(FRAME_WIDTH * frameRows);
+    frameLengths = (int *) calloc(frameRows, sizeof(int));
+    shownLengths = (int *) calloc(frameRows, sizeof(int));
+    out = (char *) malloc((FRAME_WIDTH + 16) * frameRows + 32); /* Cursor addressing of every row. */
+
+    if (!reindeerStates || !elvesStates || !frame || !shown || !frameLengths || !shownLengths || !out) {
+        freeOutput();
+
+        return 0;
+    }
+
+    for (i = 0; i < N_REINDEER; i++) {
+        reindeerStates[i] = VACATIONS;
+    }
+
+    for (i = 0; i < N_ELVES; i++) {
+        elvesStates[i] = WORKING;
+    }
+
+    memset(shown, ' ', FRAME_WIDTH * frameRows);
+    rowsShown = 0;
+
+    return 1;
+}
+
+/* Writes a whole buffer to the standard output, retrying short
+   writes. Returns 1 on success, 0 otherwise. */
+static int writeAll(const char *buffer, size_t size) {
+    ssize_t written;
+
+    while (size > 0) {
+        if ((written = write(STDOUT_FILENO, buffer, size)) <= 0) {
+            return 0;
+        }
+
+        buffer += written;
+        size -= written;
+    }
+
+    return 1;
+}
+
+/* Releases the elves' and reindeer's states, and leaves the cursor
+   below the last frame. */
+void freeOutput() {
+    char restore[32];
+    int length;
+
+    if (rowsShown) {
+        length = snprintf(restore, sizeof(restore), "\033[%d;1H\033[?25h", rowsShown + 1);
+        if (!writeAll(restore, length)) {
+            /* Nothing else can be done with the terminal. */
+        }
+        rowsShown = 0;
+    }
+
+    free(reindeerStates);
+    free(elvesStates);
+    free(frame);
+    free(shown);
+    free(frameLengths);
+    free(shownLengths);
+    free(out);
+    reindeerStates = NULL;
+    elvesStates = NULL;
+    frame = shown = out = NULL;
+    frameLengths = shownLengths = NULL;
+}
+
+/* Updates the states according to an event. */
+void applyEvent(Action newAction, int id) {
+    int i;
+
+    action = newAction;
+
+    switch (action) {
+        case SANTA_SLEPT:
+            santaState = SLEEPING;
+            break;
+        case SANTA_WOKE_UP:
+            santaState = AWAKE;
+            break;
+        case SANTA_ATTENDS_REINDEERS:
+            reindeerWantToBeAttended = 0;
+            break;
+        case SANTA_ATTENDS_ELVES:
+            elvesWantToBeAttented = 0;
+            break;
+        case REINDEER_ARRIVED:
+            reindeerThatArrived = id;
+            reindeerStates[id] = REINDEER_WAITING_SANTA;
+            break;
+        case REINDEER_ATTACHED:
+            reindeerThatWasAttached = id;
+            reindeerStates[id] = ATTACHED;
+            break;
+        case REINDEER_LEFT:
+            for (i = 0; i < N_REINDEER; i++) {
+                reindeerStates[i] = VACATIONS; /* All reindeer leave on vacations. */
+            }
+            break;
+        case REINDEER_COMPLETE:
+            reindeerWantToBeAttended = 1;
+            break;
+        case ELF_HAS_PROBLEM:
+            elfThatHadProblems = id;
+            elvesStates[id] = WITH_PROBLEM;
+            break;
+        case ELF_ARRIVED_DOOR:
+            elfThatArrivedAtTheDoor = id;
+            elvesStates[id] = ELF_WAITING_SANTA;
+            break;
+        case ELF_GOT_HELP:
+            elfThatGotHelp = id;
+            elvesStates[id] = WORKING;
+            break;
+        case ELF_COMPLETE:
+            elvesWantToBeAttented = 1;
+            break;
+        default:
+            break;
+    }
+}
+
+/*****************************************************************
+ *  Frame composition.                                           *
+ ****************************************************************/
+/* Appends formatted text to the frame, starting a new row at each
+   line break. Text beyond the frame is dropped. */
+static void put(const char *format, ...) {
+    char text[FRAME_WIDTH + 1];
+    va_list args;
+    int i, length;
+
+    va_start(args, format);
+    length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (length > FRAME_WIDTH) {
+        length = FRAME_WIDTH;
+    }
+
+    for (i = 0; i < length; i++) {
+        if (text[i] == '\n') {
+            row++;
+            column = 0;
+        }
+        else if (row < frameRows && column < FRAME_WIDTH) {
+            frame[row * FRAME_WIDTH + column++] = text[i];
+            if (column > frameLengths[row]) {
+                frameLengths[row] = column;
+            }
+        }
+    }
+}
+
+/* Appends text to the escape sequences of the frame. */
+static void emit(const char *text, int length) {
+    memcpy(out + outLength, text, length);
+    outLength += length;
+}
+
+/* Sends the rows of the composed frame that differ from the frame on
+   the terminal, from their first to their last changed character. */
+static void flushFrame() {
+    char move[24];
+    char *now, *before;
+    int r, first, last, length, rows = 0;
+
+    outLength = 0;
+    if (!rowsShown) { /* First frame: hides the cursor and clears the screen. */
+        emit("\033[?25l\033[2J", 10);
+    }
+
+    for (r = 0; r < frameRows; r++) {
+        now = frame + r * FRAME_WIDTH;
+        before = shown + r * FRAME_WIDTH;
+        length = frameLengths[r] > shownLengths[r] ? frameLengths[r] : shownLengths[r];
+
+        for (first = 0; first < length && now[first] == before[first]; first++);
+        if (first < length) {
+            for (last = length - 1; now[last] == before[last]; last--);
+
+            emit(move, snprintf(move, sizeof(move), "\033[%d;%dH", r + 1, first + 1));
+            emit(now + first, last - first + 1);
+            memcpy(before + first, now + first, last - first + 1);
+        }
+
+        shownLengths[r] = frameLengths[r];
+        if (frameLengths[r]) {
+            rows = r + 1;
+        }
+    }
+
+    if (rows > rowsShown) {
+        rowsShown = rows;
+    }
+
+    if (outLength && !writeAll(out, outLength)) {
+        /* The terminal is gone, the simulation goes on. */
+    }
+}
 
 /*****************************************************************
  *  Write of program actions and states                          *
  ****************************************************************/
 void writeOutput() {
     int i, j, idAux, actionHasNumber = 0;
-    char *actionWrite;
+    char *actionWrite = "";
 
-    sleep(1);
+    /* Starts a blank frame. */
+    memset(frame, ' ', FRAME_WIDTH * frameRows);
+    memset(frameLengths, 0, sizeof(int) * frameRows);
+    row = column = 0;
 
     /* Elves. */
-    printf("\nELVES: ");
+    put("\nELVES: ");
     for (i = 0; i < N_ELVES; i++) {
         if (i % 7 == 0 && i > 0) {
-            printf("\n%9c", ' ');
+            put("\n%9c", ' ');
         }
 
         if (elvesStates[i] == WORKING) {
-            printf("%10c", ' ');
+            put("%10c", ' ');
         }
         else if (elvesStates[i] == WITH_PROBLEM) {
-            printf("D%d%*c", i, i > 99? 6: i > 9? 7: 8, ' ');
+            put("D%d%*c", i, i > 99? 6: i > 9? 7: 8, ' ');
         }
         else if (elvesStates[i] == ELF_WAITING_SANTA) {
-            printf("%10c", ' ');
+            put("%10c", ' ');
         }
     }
-    printf("\n\n\n");
+    put("\n\n\n");
 
     /* Reindeer. */
-    printf("REINDEER: %2c", ' ');
+    put("REINDEER: %2c", ' ');
     for (i = 0; i < N_REINDEER; i++) {
         if (i % 7 == 0 && i > 0) {
-            printf("\n%9c", ' ');
+            put("\n%9c", ' ');
         }
 
         if (reindeerStates[i] == VACATIONS) {
-            printf("%10c", ' ');
+            put("%10c", ' ');
         }
         else if (reindeerStates[i] == REINDEER_WAITING_SANTA) {
-            printf("R%d%*c", i, i > 99? 6: i > 9? 7: 8, ' ');
+            put("R%d%*c", i, i > 99? 6: i > 9? 7: 8, ' ');
         }
         else if (reindeerStates[i] == ATTACHED) {
-            printf("----%*c", 5, ' ');
+            put("----%*c", 5, ' ');
         }
     }
-    printf("\n\n\n");
+    put("\n\n\n");
 
     /* Chooses the action to be printed. */
     switch (action) {
@@ -133,33 +373,34 @@ void writeOutput() {
     }
 
     /* Santa. */
-    printf("---------|        |-----------------------------------\n");
-    printf("   / \\   |        |\n");
-    printf("  /   \\  |        | %s\n", elvesWantToBeAttented ? "ELVES WANT HELP" : "");
-    printf(" /-----\\ |        |\n");
+    put("---------|        |-----------------------------------\n");
+    put("   / \\   |        |\n");
+    put("  /   \\  |        | %s\n", elvesWantToBeAttented ? "ELVES WANT HELP" : "");
+    put(" /-----\\ |        |\n");
 
     if (!actionHasNumber) {
-        printf(" | %s | |        |  %s\n", santaState == AWAKE ? "O.O" : "U.U", actionWrite);
+        put(" | %s | |        |  %s\n", santaState == AWAKE ? "O.O" : "U.U", actionWrite);
     }
     else {
-        printf(" | %s | |        |  %s %d\n", santaState == AWAKE ? "O.O" : "U.U", actionWrite, idAux);
+        put(" | %s | |        |  %s %d\n", santaState == AWAKE ? "O.O" : "U.U", actionWrite, idAux);
     }
 
-    printf(" \\-----/ |        |\n");
-    printf("  \\   /  |        | %s\n", reindeerWantToBeAttended ? "REINDEER WANT HELP" : "");
-    printf("   \\ /   |        |___________________________________\n\n");
+    put(" \\-----/ |        |\n");
+    put("  \\   /  |        | %s\n", reindeerWantToBeAttended ? "REINDEER WANT HELP" : "");
+    put("   \\ /   |        |___________________________________\n\n");
 
     for (i = 0, j = 0; i < N_ELVES; i++) {
         if (j % 5 == 0 && j > 0) {
-            printf("\n");
+            put("\n");
         }
 
         if (elvesStates[i] == ELF_WAITING_SANTA) {
-            printf("D%d%*c", i, i > 99? 6: i > 9? 7: 8, ' ');
+            put("D%d%*c", i, i > 99? 6: i > 9? 7: 8, ' ');
             j++;
         }
     }
 
-    printf("\n\n\n");
-    sem_post(&lockWrite);
+    put("\n\n\n");
+
+    flushFrame();
 }
@@ -1,3 +1,6 @@
+#ifndef DRAW_H
+#define DRAW_H
+
 /*****************************************************************
  *  Definition of states and actions.                            *
  ****************************************************************/
@@ -42,4 +45,9 @@ typedef enum {
 /*****************************************************************
  *  Functions.                                                   *
  ****************************************************************/
+int initOutput();
+void freeOutput();
+void applyEvent(Action action, int id);
 void writeOutput();
+
+#endif /* DRAW_H */
@@ -2,120 +2,180 @@
  *  Libraries import.                                            *
  ****************************************************************/
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <semaphore.h>
 
+#include "sync.h"
+#include "workshop.h"
+
 #include "elf.h"
-#include "draw.h"
+#include "eventlog.h"
+#include "bench.h"
+#include "trace.h"
 
 /*****************************************************************
  *  Global variables initialization.                             *
  ****************************************************************/
-/* Counters. */
-extern int elves; /* Counter of elves with problems. */
-
-/* States used for writing the output. */
-extern ElfState *elvesStates;
-extern Action action;
-extern int elfThatGotHelp;
-extern int elfThatArrivedAtTheDoor;
-extern int elfThatHadProblems;
-extern int elvesWantToBeAttented;
-
-/* Semaphores. */
-extern sem_t semSanta;
-extern sem_t semElf;
-extern sem_t semDoor;
-extern sem_t lockCounters;
-extern sem_t lockWaitForWork;
-extern sem_t lockWaitForLastReindeer;
-extern sem_t lockWrite;
-
-/* Constants. */
-const int N_ELVES = 15; /* Amount of elves in the simulation. */
-const int ELVES_GROUP_SIZE = 3; /* Minimum amount of elves with problem so that Santa wakes up. */
+/* Parameters. */
+int N_ELVES = 15; /* Amount of elves in the simulation. */
+int ELVES_GROUP_SIZE = 3; /* Minimum amount of elves with problem so that Santa wakes up. */
+int elfWorkers = 0; /* Worker threads impersonating elves, 0 for one thread per elf. */
 
 /*****************************************************************
  *  Actions simulation.                                          *
  ****************************************************************/
 /* Function triggered by each elf when they will get help from Santa. */
-void getHelp(int id){
-    sem_wait(&lockCounters); /* Acquire counters lock. */
+void getHelp(SantaWorkshop *w, int id){
+    logEvent(ELF_GOT_HELP, id); /* Elf starts to work again. */
+    w->elfHelps[id]++;
+
+    /* After getting help, decreases elves counter. */
+    if (atomic_fetch_sub(&w->elves, 1) == 1) { /* When the last elf gets help. */
+        syncPost(&w->lockWaitForWork); /* Allows Santa to sleep. */
+        syncPost(&w->semDoor); /* Releases door lock. */
+    }
+
+    nap(30);
+}
 
-    sem_wait(&lockWrite); /* Acquire lock for printing output. */
+/* Makes an elf have a problem, wait at the door and get help.
+   Returns 0 if the simulation is finishing. */
+int elfCycle(SantaWorkshop *w, int id) {
+    int generation;
 
-    elvesStates[id] = WORKING; /* Elf starts to work again. */
+    logEvent(ELF_HAS_PROBLEM, id); /* Elf has a problem. */
 
-    action = ELF_GOT_HELP;
-    elfThatGotHelp = id;
-    writeOutput();
+    syncWait(&w->semDoor); /* Elf gets in and shuts the door to ask Santa help. */
+    if (stopping()) {
+        return 0;
+    }
+
+    logEvent(ELF_ARRIVED_DOOR, id); /* Elf waits for Santa to wake up. */
 
-    elves--; /* After getting help, decreases elves counter. */
+    /* Joins the group waiting for Santa before being counted, so Santa
+       can only open the gate after every member of the group is in. */
+    generation = gateEnter(&w->gateElf);
 
-    if (elves == 0) { /* When the last elf gets help. */
-        sem_post(&lockWaitForWork); /* Allows Santa to sleep. */
-        sem_post(&semDoor); /* Releases door lock. */
+    /* Increases the number of elves at the door. */
+    if (atomic_fetch_add(&w->elves, 1) + 1 == ELVES_GROUP_SIZE) { /* If the number of elves at the door reaches the minimum.*/
+        logEvent(ELF_COMPLETE, -1);
+
+        atomic_store(&w->elvesSignaledAt, nowNs());
+        syncPost(&w->semSanta); /* Signals to wake Santa up. */
+    }
+    else { /* Otherwise */
+        syncPost(&w->semDoor); /* Opens the door. */
     }
 
-    sem_post(&lockCounters); /* Releases counters lock. */
+    gateWait(&w->gateElf, generation); /* Elves sleep at the door until Santa wakes up. */
+    if (stopping()) {
+        return 0;
+    }
+
+    recordLatency(&w->elfWakeup, nowNs() - w->elvesReleasedAt);
 
-    sleep(random() % 30);
+    getHelp(w, id); /* When wakes up, the elf ask for help. */
+
+    return !stopping();
 }
 
 /*****************************************************************
- *  Thread body. Randomly makes an elf have problems.            *
+ *  Worker pool.                                                 *
+ *                                                               *
+ *  With a very large number of elves, a few worker threads can  *
+ *  take turns impersonating them instead of having one thread   *
+ *  per elf. Elves not impersonated by any worker are working.   *
+ *  There must be at least ELVES_GROUP_SIZE workers, so a whole  *
+ *  group can wait at the door at the same time.                 *
  ****************************************************************/
-void* felf(void *v) {
-	int id = * (int*) v;
+/* Fills the FIFO with all elves. Returns 1 on success. */
+int initElfPool(SantaWorkshop *w) {
+    int i;
+
+    w->idleElves = (int *) malloc(sizeof(int) * N_ELVES);
+    if (!w->idleElves) {
+        return 0;
+    }
+
+    for (i = 0; i < N_ELVES; i++) {
+        w->idleElves[i] = i;
+    }
+    w->idleFront = 0;
+    w->idleCount = N_ELVES;
+    pthread_mutex_init(&w->idleLock, NULL);
 
-	sleep(random() % 10);
+    return 1;
+}
 
-	while (1) {
-        /* Write state. */
-        sem_wait(&lockWrite); /* Acquire lock for printing output. */
+/* Releases the FIFO. */
+void freeElfPool(SantaWorkshop *w) {
+    if (w->idleElves) {
+        free(w->idleElves);
+        w->idleElves = NULL;
+        pthread_mutex_destroy(&w->idleLock);
+    }
+}
 
-        elvesStates[id] = WITH_PROBLEM; /* Elf has a problem. */
+/* Takes the elf that has been idle for the longest. Since there are
+   no more workers than elves, there is always one. */
+static int takeIdleElf(SantaWorkshop *w) {
+    int id;
 
-        action = ELF_HAS_PROBLEM;
-        elfThatHadProblems = id;
-        writeOutput();
+    pthread_mutex_lock(&w->idleLock);
+    id = w->idleElves[w->idleFront];
+    w->idleFront = (w->idleFront + 1) % N_ELVES;
+    w->idleCount--;
+    pthread_mutex_unlock(&w->idleLock);
 
-        sem_wait(&semDoor); /* Elf gets in and shuts the door to ask Santa help. */
+    return id;
+}
 
-        /* Write state. */
-        sem_wait(&lockWrite);
+/* Puts an elf back at the end of the FIFO. */
+static void returnIdleElf(SantaWorkshop *w, int id) {
+    pthread_mutex_lock(&w->idleLock);
+    w->idleElves[(w->idleFront + w->idleCount) % N_ELVES] = id;
+    w->idleCount++;
+    pthread_mutex_unlock(&w->idleLock);
+}
 
-        elvesStates[id] = ELF_WAITING_SANTA; /* Elf waits for Santa to wake up. */
+/*****************************************************************
+ *  Thread bodies. Randomly makes elves have problems.           *
+ ****************************************************************/
+/* One thread per elf. */
+void* felf(void *v) {
+	SantaWorkshop *w = ((Actor *) v)->workshop;
+	int id = ((Actor *) v)->id;
 
-        action = ELF_ARRIVED_DOOR;
-        elfThatArrivedAtTheDoor = id;
-        writeOutput();
+	traceThread(w->id, "elf", id);
 
-		sem_wait(&lockCounters); /* Acquire counters lock. */
+	nap(10);
 
-		elves++; /* Increases the number of elves at the door. */
+	while (!stopping() && elfCycle(w, id));
 
-		if (elves == ELVES_GROUP_SIZE)	{ /* If the number of elves at the door reaches the minimum.*/
-            /* Write state. */
-            sem_wait(&lockWrite);
-            action = ELF_COMPLETE;
-            elvesWantToBeAttented = 1;
-            writeOutput();
+	return NULL;
+}
 
-			sem_post(&semSanta); /* Signals to wake Santa up. */
-		}
-		else { /* Otherwise */
-            sem_post(&semDoor); /* Opens the door. */
-		}
+/* One thread per worker, impersonating any elf. */
+void* felfWorker(void *v) {
+    SantaWorkshop *w = ((Actor *) v)->workshop;
+    int id;
 
-		sem_post(&lockCounters); /* Release counters lock. */
+    traceThread(w->id, "worker", ((Actor *) v)->id);
 
-        sem_wait(&semElf); /* Elves sleep at the door until Santa wakes up. */
+    nap(10);
 
-		getHelp(id); /* When wakes up, the elf ask for help. */
-	}
+    while (!stopping()) {
+        id = takeIdleElf(w);
 
-	return NULL;
+        if (!elfCycle(w, id)) {
+            break;
+        }
+
+        returnIdleElf(w, id);
+    }
+
+    return NULL;
 }
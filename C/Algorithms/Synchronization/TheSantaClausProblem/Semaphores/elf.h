@@ -1,11 +1,18 @@
 /*****************************************************************
- *  Constants definition.                                        *
+ *  Parameters definition.                                         *
  ****************************************************************/
-extern const int N_ELVES;
-extern const int ELVES_GROUP_SIZE;
+extern int N_ELVES;
+extern int ELVES_GROUP_SIZE;
+extern int elfWorkers;
 
 /*****************************************************************
  *  Functions.                                                   *
  ****************************************************************/
-void getHelp(int id);
+struct santaWorkshop;
+
+void getHelp(struct santaWorkshop *w, int id);
+int elfCycle(struct santaWorkshop *w, int id);
+int initElfPool(struct santaWorkshop *w);
+void freeElfPool(struct santaWorkshop *w);
 void* felf(void *v);
+void* felfWorker(void *v);
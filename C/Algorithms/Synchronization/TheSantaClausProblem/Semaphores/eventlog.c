@@ -0,0 +1,207 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "eventlog.h"
+#include "draw.h"
+#include "bench.h"
+#include "sim.h"
+
+/*****************************************************************
+ *  Event buffer.                                                *
+ *                                                               *
+ *  Bounded multi-producer ring buffer. Each slot carries a      *
+ *  sequence number telling whether it is free for the producer  *
+ *  of a given position or holds an event ready for the          *
+ *  renderer, so producers never take a lock. Only the renderer  *
+ *  thread consumes events.                                      *
+ ****************************************************************/
+typedef struct {
+    atomic_size_t sequence;
+    Event event;
+} Slot;
+
+static Slot *slots;
+static size_t mask;
+static atomic_size_t head; /* Next position to be written by a producer. */
+static size_t tail; /* Next position to be read by the renderer. */
+
+/* Renderer thread and its settings. */
+static pthread_t renderer;
+static int pacing; /* Milliseconds between two rendered events. */
+static long frameInterval; /* Minimum nanoseconds between two frames, 0 to draw every event. */
+static atomic_int running;
+
+/*****************************************************************
+ *  Auxiliary functions.                                         *
+ ****************************************************************/
+/* Sleeps for the given amount of milliseconds. */
+static void sleepMs(int ms) {
+    struct timespec ts;
+
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+/* Takes the oldest event from the buffer. Returns 0 if it is empty. */
+static int popEvent(Event *event) {
+    Slot *slot = &slots[tail & mask];
+
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != tail + 1) {
+        return 0;
+    }
+
+    *event = slot->event;
+    atomic_store_explicit(&slot->sequence, tail + mask + 1, memory_order_release);
+    tail++;
+
+    return 1;
+}
+
+/*****************************************************************
+ *  Thread body. Draws the events as they are logged.            *
+ *                                                               *
+ *  When pacing, or without a frame rate cap, each event gets    *
+ *  its own frame. Otherwise, all events logged since the last   *
+ *  frame are applied at once, and drawn in a single frame when  *
+ *  the cap allows it, so bursts of events cost one frame.       *
+ ****************************************************************/
+static void* frenderer(void *v) {
+    Event event;
+    long lastFrame = 0;
+    int pending = 0; /* Events applied but not drawn yet. */
+    int finishing;
+
+    (void) v;
+
+    while (1) {
+        /* Read before draining, so no event logged before the end is missed. */
+        finishing = !atomic_load(&running);
+
+        while (popEvent(&event)) {
+            applyEvent(event.action, event.id);
+            pending++;
+
+            if (pacing > 0 || !frameInterval) {
+                break;
+            }
+        }
+
+        if (pending && (pacing > 0 || finishing || wallNs() - lastFrame >= frameInterval)) {
+            writeOutput();
+            pending = 0;
+            lastFrame = wallNs();
+
+            if (pacing > 0) {
+                sleepMs(pacing);
+            }
+        }
+        else if (!pending && finishing) { /* Stops once drained. */
+            break;
+        }
+        else {
+            sleepMs(1); /* Nothing to draw yet, or too early for the next frame. */
+        }
+    }
+
+    return NULL;
+}
+
+/*****************************************************************
+ *  Event log control.                                           *
+ ****************************************************************/
+/* Allocates the buffer and starts the renderer thread. The capacity
+   is rounded up to a power of 2. Without pacing, at most maxFps frames
+   are drawn per second, or one per event if it is 0. Returns 1 on
+   success, 0 otherwise. */
+int startEventLog(int capacity, int pacingMs, int maxFps) {
+    size_t i, n;
+
+    for (n = 2; n < (size_t) capacity; n *= 2);
+
+    slots = (Slot *) malloc(sizeof(Slot) * n);
+    if (!slots) {
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        atomic_init(&slots[i].sequence, i);
+    }
+
+    mask = n - 1;
+    atomic_init(&head, 0);
+    tail = 0;
+    pacing = pacingMs;
+    frameInterval = maxFps > 0 ? 1000000000L / maxFps : 0;
+    atomic_init(&running, 1);
+
+    if (pthread_create(&renderer, NULL, frenderer, NULL)) {
+        free(slots);
+        slots = NULL;
+
+        return 0;
+    }
+
+    return 1;
+}
+
+/* Appends an event to the buffer. It only waits if the buffer is
+   full, i.e., when the renderer is far behind the simulation. */
+void logEvent(Action action, int id) {
+    Slot *slot;
+    size_t pos, seq;
+    intptr_t diff;
+
+    if (simulated) {
+        simDigest(action, id);
+    }
+
+    if (!slots) { /* Nothing is drawn. */
+        return;
+    }
+
+    pos = atomic_load_explicit(&head, memory_order_relaxed);
+    while (1) {
+        slot = &slots[pos & mask];
+        seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        diff = (intptr_t) seq - (intptr_t) pos;
+
+        if (diff == 0) { /* Slot is free: tries to claim the position. */
+            if (atomic_compare_exchange_weak_explicit(&head, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) { /* Buffer is full. */
+            sched_yield();
+            pos = atomic_load_explicit(&head, memory_order_relaxed);
+        }
+        else { /* Another producer claimed the position. */
+            pos = atomic_load_explicit(&head, memory_order_relaxed);
+        }
+    }
+
+    slot->event.action = action;
+    slot->event.id = id;
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+}
+
+/* Draws the remaining events and stops the renderer thread. */
+void stopEventLog() {
+    if (!slots) {
+        return;
+    }
+
+    atomic_store(&running, 0);
+    pthread_join(renderer, NULL);
+
+    free(slots);
+    slots = NULL;
+}
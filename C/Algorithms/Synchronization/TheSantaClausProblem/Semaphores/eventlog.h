@@ -0,0 +1,22 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include "draw.h"
+
+/*****************************************************************
+ *  Definition of events.                                        *
+ ****************************************************************/
+/* Compact record of something that happened in the simulation. */
+typedef struct {
+    Action action;
+    int id; /* Elf or reindeer that performed the action, -1 if none. */
+} Event;
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+int startEventLog(int capacity, int pacingMs, int maxFps);
+void logEvent(Action action, int id);
+void stopEventLog();
+
+#endif /* EVENTLOG_H */
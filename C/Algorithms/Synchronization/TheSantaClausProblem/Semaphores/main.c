@@ -1,121 +1,287 @@
 /*****************************************************************
  *  Libraries import.                                            *
  ****************************************************************/
+#include <errno.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <semaphore.h>
+#include <time.h>
+
+#include "sync.h"
+#include "workshop.h"
 
 #include "reindeer.h"
 #include "santa.h"
 #include "draw.h"
+#include "eventlog.h"
 #include "elf.h"
+#include "bench.h"
+#include "trace.h"
+#include "sim.h"
 
 /*****************************************************************
  *  Global variables initialization.                             *
  ****************************************************************/
-/* Counters. */
-int elves = 0; /* Counter of elves with problems. */
-int reindeer = 0; /* Counter of reindeer back from vacations. */
-
-/* States used for writing the output. */
-SantaState santaState;
-ElfState *elvesStates;
-ReindeerState *reindeerStates;
-Action action;
-int reindeerThatArrived;
-int reindeerThatWasAttached;
-int reindeerWantToBeAttended = 0;
-int elfThatGotHelp;
-int elfThatArrivedAtTheDoor;
-int elfThatHadProblems;
-int elvesWantToBeAttented = 0;
-
-/* Semaphores. */
-sem_t semSanta;
-sem_t semReindeer;
-sem_t semElf;
-sem_t semDoor;
-sem_t lockCounters;
-sem_t lockWaitForWork;
-sem_t lockWaitForLastReindeer;
-sem_t lockWrite;
-
-/* Constants. */
-extern const int N_REINDEER; /* Amount of reindeer in the sleigh. */
-extern const int N_ELVES; /* Amount of reindeer in the sleigh. */
+/* Signaled by each workshop's Santa when its rounds are over. */
+sem_t semDone;
+
+/* Settings of the output. */
+#define EVENT_LOG_CAPACITY 4096 /* Events that can wait to be drawn. */
+#define DEFAULT_MAX_FPS 30 /* Frames per second drawn without pacing. */
+
+/* Stack size of each elf and reindeer thread. They barely use it, and
+   the default of several megabytes limits how many threads can exist. */
+#define THREAD_STACK_SIZE (64 * 1024)
+
+/* Where the trace is written when built with -DSANTA_TRACE. */
+#define TRACE_FILE "santa_trace.json"
+
+/*****************************************************************
+ *  Auxiliary functions.                                         *
+ ****************************************************************/
+/* Prints the command line options. */
+void usage(char *program) {
+    fprintf(stderr, "Usage: %s [-H] [-e elves] [-r reindeer] [-g group_size]\n"
+        "          [-n rounds] [-t seconds] [-p pacing_ms] [-f fps] [-s backend]\n"
+        "          [-w workers] [-W workshops] [-d seed]\n"
+        "  -H  headless benchmark: no output, no pauses, prints statistics at the end\n"
+        "  -e  number of elves (default %d)\n"
+        "  -r  number of reindeer (default %d)\n"
+        "  -g  elves needed to wake Santa up (default %d)\n"
+        "  -n  stop after Santa attends this many groups\n"
+        "  -t  stop after this many seconds (simulated seconds with -d)\n"
+        "  -p  milliseconds the renderer waits after drawing each event (default 1000)\n"
+        "  -f  with -p 0, frames drawn per second at most, 0 for one per event (default %d)\n"
+        "  -s  synchronization backend: sem, condvar, futex or spin (default %s)\n"
+        "  -w  worker threads taking turns as elves, instead of one thread per elf\n"
+        "  -W  independent workshops running at the same time, headless only (default 1)\n"
+        "  -d  deterministic run with the given seed: coroutines and simulated time\n"
+        "      instead of threads and real time; it needs -n or -t\n",
+        program, N_ELVES, N_REINDEER, ELVES_GROUP_SIZE, DEFAULT_MAX_FPS, syncBackendName());
+}
+
+/* Waits until the requested rounds are over in all n workshops or
+   the time limit expires. Without any of them, it waits forever. */
+void waitForEnd(int n, double seconds) {
+    struct timespec deadline;
+    int i;
+
+    if (seconds <= 0) {
+        for (i = 0; i < n; i++) {
+            while (sem_wait(&semDone) == -1);
+        }
+        return;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += (time_t) seconds;
+    deadline.tv_nsec += (long) ((seconds - (time_t) seconds) * 1e9);
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    for (i = 0; i < n; i++) {
+        while (sem_timedwait(&semDone, &deadline) == -1) {
+            if (errno != EINTR) {
+                return; /* Time is over. */
+            }
+        }
+    }
+}
+
+/* Runs the deterministic scheduler until the requested rounds are
+   over in all n workshops or the simulated time limit expires. */
+void runSimulation(int n, double seconds) {
+    long deadline = seconds > 0 ? (long) (seconds * 1e9) : 0;
+    int done = 0;
+
+    while (done < n && simStep(deadline)) {
+        sem_getvalue(&semDone, &done);
+    }
+}
+
+/* Stops the first n workshops and waits for all the threads they
+   started, even when they did not start all of them. */
+void stopWorkshops(SantaWorkshop *workshops, int n) {
+    int i;
+
+    atomic_store_explicit(&stop, 1, memory_order_release);
+    for (i = 0; i < n; i++) {
+        releaseWorkshop(&workshops[i]);
+    }
+
+    /* Lets the coroutines see the stop flag and end. */
+    while (simulated && simStep(0));
+    for (i = 0; i < n; i++) {
+        joinWorkshop(&workshops[i]);
+    }
+}
 
 /*****************************************************************
  *  Main.                                                        *
  ****************************************************************/
 int main (int argc, char *argv[]) {
-    /* Santa thread. */
-    pthread_t santa;
+    /* Independent simulations. */
+    SantaWorkshop *workshops;
+    int nWorkshops = 1;
 
-	/* Reindeer threads and their IDs arrays. */
-	pthread_t *reindeer = (pthread_t *) malloc(sizeof(pthread_t) * N_REINDEER);
-	int *reindeerIds = (int *) malloc(sizeof(int) * N_REINDEER);
+    pthread_attr_t attr;
+    int i, started, opt, pacingMs = 1000, maxFps = DEFAULT_MAX_FPS;
+    double seconds = 0;
+    long rounds = 0, start;
 
-	/* Elves threads and their IDs arrays. */
-	pthread_t *elves = (pthread_t *) malloc(sizeof(pthread_t) * N_ELVES);
-    int *elvesIds = (int *) malloc(sizeof(int) * N_ELVES);
+    /* Command line options. */
+    while ((opt = getopt(argc, argv, "He:r:g:n:t:p:f:s:w:W:d:")) != -1) {
+        switch (opt) {
+            case 'H':
+                headless = 1;
+                break;
+            case 'e':
+                N_ELVES = atoi(optarg);
+                break;
+            case 'r':
+                N_REINDEER = atoi(optarg);
+                break;
+            case 'g':
+                ELVES_GROUP_SIZE = atoi(optarg);
+                break;
+            case 'n':
+                rounds = atol(optarg);
+                break;
+            case 't':
+                seconds = atof(optarg);
+                break;
+            case 'p':
+                pacingMs = atoi(optarg);
+                break;
+            case 'f':
+                maxFps = atoi(optarg);
+                break;
+            case 'w':
+                elfWorkers = atoi(optarg);
+                break;
+            case 'W':
+                nWorkshops = atoi(optarg);
+                break;
+            case 'd':
+                simulated = 1;
+                simSeed = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                if (!setSyncBackend(optarg)) {
+                    fprintf(stderr, "Unknown synchronization backend: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
 
-    int i;
+    if (N_ELVES < 1 || N_REINDEER < 1 || ELVES_GROUP_SIZE < 1 || ELVES_GROUP_SIZE > N_ELVES) {
+        fprintf(stderr, "There must be at least one reindeer and one group of elves.\n");
+        return 1;
+    }
+
+    if (elfWorkers && (elfWorkers < ELVES_GROUP_SIZE || elfWorkers > N_ELVES)) {
+        fprintf(stderr, "There must be between %d and %d elf workers.\n", ELVES_GROUP_SIZE, N_ELVES);
+        return 1;
+    }
+
+    /* Simulated runs only end when told to, since nothing else would
+       make the scheduler stop. */
+    if (simulated) {
+        if (rounds <= 0 && seconds <= 0) {
+            fprintf(stderr, "Deterministic runs need -n or -t.\n");
+            return 1;
+        }
+        setSyncBackend("sim");
+    }
+    else if (!strcmp(syncBackendName(), "sim")) {
+        fprintf(stderr, "The sim backend is only available with -d.\n");
+        return 1;
+    }
 
-    /* Semaphore initialization. */
-    sem_init (&semSanta, 0, 0);
-    sem_init (&semReindeer, 0, 0);
-    sem_init (&semElf, 0, 0);
-    sem_init (&semDoor, 0, 1);
-    sem_init (&lockCounters, 0, 1);
-    sem_init (&lockWaitForWork, 0, 0);
-    sem_init (&lockWaitForLastReindeer, 0, 0);
-    sem_init (&lockWrite, 0, 1);
+    /* The output only shows one workshop. */
+    if (nWorkshops < 1 || (nWorkshops > 1 && !headless)) {
+        fprintf(stderr, "There must be one workshop, or any number of them with -H.\n");
+        return 1;
+    }
+
+    workshops = (SantaWorkshop *) aligned_alloc(CACHE_LINE_SIZE, sizeof(SantaWorkshop) * nWorkshops);
+    if (!workshops) {
+        fprintf(stderr, "Could not allocate memory.\n");
+        return 1;
+    }
 
-    /* Santa's state initialization. */
-    santaState = SLEEPING;
+    sem_init (&semDone, 0, 0);
 
-    /* Reindeer's state initialization. */
-    reindeerStates = (ReindeerState *) malloc(sizeof(ReindeerState) * N_REINDEER);
-    for (i = 0; i < N_REINDEER; i++) {
-        reindeerStates[i] = VACATIONS;
+    for (i = 0; i < nWorkshops; i++) {
+        if (!initWorkshop(&workshops[i], i, rounds, &semDone)) {
+            fprintf(stderr, "Could not allocate memory.\n");
+            return 1;
+        }
     }
 
-    /* Elves' state initialization. */
-    elvesStates = (ElfState *) malloc(sizeof(ElfState) * N_ELVES);
-    for (i = 0; i < N_ELVES; i++) {
-        elvesStates[i] = WORKING;
+    /* Output states initialization. Events are drawn by a separate
+       thread, so the simulation never waits for the terminal. */
+    if (!headless && (!initOutput() || !startEventLog(EVENT_LOG_CAPACITY, pacingMs, maxFps))) {
+        fprintf(stderr, "Could not start the output.\n");
+        return 1;
+    }
+
+    startStatistics();
+    traceStart();
+    start = wallNs();
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, THREAD_STACK_SIZE);
+
+    /* A workshop that fails to start may have started some of its
+       threads, so it is stopped along with the ones before it. */
+    for (started = 0; started < nWorkshops; started++) {
+        if (!startWorkshop(&workshops[started], &attr, THREAD_STACK_SIZE)) {
+            break;
+        }
     }
 
-    /* Seed for generation of random numbers. */
-    srand(time(NULL));
+    pthread_attr_destroy(&attr);
 
-	/* Creation of Santa's thread. */
-	pthread_create(&santa, NULL, fsanta, NULL);
+    /* Simulation execution. */
+    if (started < nWorkshops) {
+        stopWorkshops(workshops, started + 1);
+    }
+    else {
+        if (simulated) {
+            runSimulation(nWorkshops, seconds);
+        }
+        else {
+            waitForEnd(nWorkshops, seconds);
+        }
 
-	/* Creation of reindeer's threads. */
-	for (i = 0; i < N_REINDEER; i++) {
-		reindeerIds[i] = i;
-		pthread_create(&reindeer[i], NULL, freindeer, (void*) &reindeerIds[i]);
-	}
+        stopWorkshops(workshops, nWorkshops);
+    }
 
-	/* Creation of elves' threads. */
-	for (i = 0; i < N_ELVES; i++) {
-		elvesIds[i] = i;
-		pthread_create(&elves[i], NULL, felf, (void*) &elvesIds[i]);
-	}
+    if (headless && started == nWorkshops) {
+        printReport(workshops, nWorkshops, (wallNs() - start) / 1e9);
+    }
 
-    /* Santa's thread execution. */
-    pthread_join(santa, NULL);
+    traceFinish(TRACE_FILE);
 
     /* Releases memory. */
-    free(reindeer);
-    free(reindeerIds);
-    free(elves);
-    free(elvesIds);
-    free(reindeerStates);
-    free(elvesStates);
-
-	return 0;
+    stopEventLog();
+    freeOutput();
+    for (i = 0; i < nWorkshops; i++) {
+        freeWorkshop(&workshops[i]);
+    }
+    free(workshops);
+    sem_destroy(&semDone);
+
+	return started == nWorkshops ? 0 : 1;
 }
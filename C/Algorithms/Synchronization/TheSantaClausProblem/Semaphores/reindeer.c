@@ -2,83 +2,58 @@
  *  Libraries import.                                            *
  ****************************************************************/
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <semaphore.h>
 
+#include "sync.h"
+#include "workshop.h"
+
 #include "reindeer.h"
-#include "draw.h"
+#include "eventlog.h"
+#include "bench.h"
+#include "trace.h"
 
 /*****************************************************************
  *  Global variables initialization.                             *
  ****************************************************************/
-/* Counters. */
-extern int reindeer; /* Counter of reindeer that are back from vacations. */
-
-/* States used for writing the output. */
-extern ReindeerState *reindeerStates;
-extern Action action;
-extern int reindeerThatArrived;
-extern int reindeerThatWasAttached;
-extern int reindeerWantToBeAttended;
-
-/* Semaphores. */
-extern sem_t semSanta;
-extern sem_t semReindeer;
-extern sem_t semDoor;
-extern sem_t lockCounters;
-extern sem_t lockWaitForWork;
-extern sem_t lockWaitForLastReindeer;
-extern sem_t lockWrite;
-
-/* Constants. */
-const int N_REINDEER = 8; /* Amount of reindeer in the sleigh. */
+/* Parameters. */
+int N_REINDEER = 8; /* Amount of reindeer in the sleigh. */
 
 /*****************************************************************
  *  Actions simulation.                                          *
  ****************************************************************/
 /* Function triggered by each reindeer to get attached after the sleigh gets fixed. */
-void getHitched(int id) {
-    int i;
-
-    sem_wait(&lockCounters); /* Acquire counters lock. */
-
-    reindeer--; /* After getting help, decreases reindeer counter. */
+void getHitched(SantaWorkshop *w, int id) {
+    int generation;
 
-    /* Print that a reindeer got attached. */
-    sem_wait(&lockWrite);
+    logEvent(REINDEER_ATTACHED, id); /* Print that a reindeer got attached. */
 
-    action = REINDEER_ATTACHED;
+    /* Joins the reindeer waiting for the last one before being
+       counted, so the gate cannot be opened before it is in. */
+    generation = gateEnter(&w->gateLastReindeer);
 
-    reindeerThatWasAttached = id;
-    reindeerStates[id] = ATTACHED;
-    writeOutput();
+    /* After getting help, decreases reindeer counter. */
+    if (atomic_fetch_sub(&w->reindeer, 1) == 1) { /* When the last reindeer attaches. */
+        gateLeave(&w->gateLastReindeer); /* The last one does not wait. */
 
-    if (reindeer == 0) { /* When the last reindeer attaches. */
-        sem_post(&lockWaitForWork); /* Allows Santa to get back to sleep. */
-
-        for (i = 1; i < N_REINDEER; i++) {
-            sem_post(&lockWaitForLastReindeer); /* Allows the sleigh to leave. */
-        }
+        syncPost(&w->lockWaitForWork); /* Allows Santa to get back to sleep. */
 
-        /* Write output. */
-        sem_wait(&lockWrite);
-        for (i = 0; i < N_REINDEER; i++) {
-            reindeerStates[i] = VACATIONS; /* All reindeer will leave on vacations thereafter. */
-        }
-        action = REINDEER_LEFT;
-        writeOutput();
+        gateOpen(&w->gateLastReindeer); /* Allows the sleigh to leave. */
 
-        sem_post(&lockCounters); /* Release counters lock. */
+        logEvent(REINDEER_LEFT, -1); /* All reindeer will leave on vacations thereafter. */
 
-        sleep(random() % 50);
+        nap(50);
     }
     else { /* If there are more reindeer to return. */
-        sem_post(&lockCounters); /* Release counters lock. */
-        sem_wait(&lockWaitForLastReindeer); /* Wait for the remaining reindeer. */
+        gateWait(&w->gateLastReindeer, generation); /* Wait for the remaining reindeer. */
+        if (stopping()) {
+            return;
+        }
 
-        sleep(random() % 50);
+        nap(50);
     }
 }
 
@@ -86,42 +61,35 @@ void getHitched(int id) {
  *  Thread body. Randomly makes a reindeer get back.             *
  ****************************************************************/
 void* freindeer(void *v) {
-	int id = * (int*) v;
-
-	sleep(random() % 15);
+	SantaWorkshop *w = ((Actor *) v)->workshop;
+	int id = ((Actor *) v)->id;
+    int generation;
 
-	while (1) {
-		sem_wait(&lockCounters); /* Acquire counters lock. */
+	traceThread(w->id, "reindeer", id);
 
-        reindeer++; /* A new reindeer has returned. */
+	nap(15);
 
-        /* Write state. */
-        sem_wait(&lockWrite);
+	while (!stopping()) {
+        logEvent(REINDEER_ARRIVED, id);
 
-        reindeerThatArrived = id;
-        action = REINDEER_ARRIVED;
-        reindeerStates[id] = REINDEER_WAITING_SANTA;
-        writeOutput();
+        generation = gateEnter(&w->gateReindeer); /* Joins the reindeer waiting for Santa. */
 
-        if (reindeer == N_REINDEER) { /* Last reindeer to return. */
-            /* Write state. */
-            sem_wait(&lockWrite);
+        /* A new reindeer has returned. */
+        if (atomic_fetch_add(&w->reindeer, 1) + 1 == N_REINDEER) { /* Last reindeer to return. */
+            logEvent(REINDEER_COMPLETE, -1);
 
-            action = REINDEER_COMPLETE;
-            reindeerWantToBeAttended = 1;
-            writeOutput();
-
-            sem_post(&semSanta); /* Signals to wake Santa up. */
+            atomic_store(&w->reindeerSignaledAt, nowNs());
+            syncPost(&w->semSanta); /* Signals to wake Santa up. */
         }
 
-		sem_post(&lockCounters); /* Release counters lock. */
-		sem_wait(&semReindeer); /* Reindeer sleep until Santa wakes them up. */
+		gateWait(&w->gateReindeer, generation); /* Reindeer sleep until Santa wakes them up. */
+        if (stopping()) {
+            break;
+        }
 
-		getHitched(id); /* When they wake up, they get attached to the sleigh. */
+        recordLatency(&w->reindeerWakeup, nowNs() - w->reindeerReleasedAt);
 
-        /* Write state. */
-        sem_wait(&lockWrite);
-        writeOutput();
+		getHitched(w, id); /* When they wake up, they get attached to the sleigh. */
 	}
 
 	return NULL;
@@ -1,10 +1,12 @@
 /*****************************************************************
- *  Constants definition.                                        *
+ *  Parameters definition.                                         *
  ****************************************************************/
-extern const int N_REINDEER;
+extern int N_REINDEER;
 
 /*****************************************************************
  *  Functions.                                                   *
  ****************************************************************/
-void getHitched(int id);
+struct santaWorkshop;
+
+void getHitched(struct santaWorkshop *w, int id);
 void* freindeer(void *v);
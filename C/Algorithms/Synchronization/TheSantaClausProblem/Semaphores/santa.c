@@ -2,115 +2,140 @@
  *  Libraries import.                                            *
  ****************************************************************/
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <semaphore.h>
 
+#include "sync.h"
+#include "workshop.h"
+
 #include "santa.h"
 #include "reindeer.h"
 #include "elf.h"
-#include "draw.h"
-
-/*****************************************************************
- *  Global variables initialization.                             *
- ****************************************************************/
-/* Counters. */
-extern int elves; /* Counter of elves with problems. */
-extern int reindeer; /* Counter of reindeer that returned from vacations. */
-
-/* States used for writing the output. */
-extern SantaState santaState;
-extern Action action;
-extern int reindeerWantToBeAttended;
-extern int elvesWantToBeAttented;
-
-/* Semaphores. */
-extern sem_t semSanta;
-extern sem_t semReindeer;
-extern sem_t semElf;
-extern sem_t semDoor;
-extern sem_t lockCounters;
-extern sem_t lockWaitForWork;
-extern sem_t lockWaitForLastReindeer;
-extern sem_t lockWrite;
+#include "eventlog.h"
+#include "bench.h"
+#include "trace.h"
 
 /*****************************************************************
  *  Actions simulation.                                          *
  ****************************************************************/
 /* Function triggered for Santa to prepare the sleigh. */
 void prepareSleigh(){
-    /* Write output. */
-    sem_wait(&lockWrite);
-    action = SANTA_PREPARED_SLEIGH;
-    writeOutput();
+    logEvent(SANTA_PREPARED_SLEIGH, -1);
 }
 
 /* Function triggered for Santa to help the elves. */
 void helpElves(){
-    /* Write output. */
-    sem_wait(&lockWrite);
-    action = SANTA_HELPED_ELVES;
-    writeOutput();
+    logEvent(SANTA_HELPED_ELVES, -1);
+}
+
+/* Opens the gate of a complete elf group and helps it. */
+static void attendElves(SantaWorkshop *w, long wokeAt) {
+    long signaledAt;
+
+    signaledAt = atomic_exchange(&w->elvesSignaledAt, 0);
+    if (signaledAt) {
+        recordLatency(&w->santaWakeup, wokeAt - signaledAt);
+    }
+
+    logEvent(SANTA_ATTENDS_ELVES, -1);
+
+    w->elvesReleasedAt = nowNs();
+    gateOpen(&w->gateElf); /* Wakes all elves up. */
+
+    helpElves(); /* Helps the elves. */
+}
+
+/* Waits for the group attended to be done and counts the round.
+   Returns 0 if the simulation is finishing. */
+static int finishRound(SantaWorkshop *w, int attendedReindeer) {
+    syncWait(&w->lockWaitForWork); /* Wait all reindeer to attach or all elves get help so that he can sleep again. */
+    if (stopping()) {
+        return 0;
+    }
+
+    if (attendedReindeer) {
+        w->sleighLaunches++;
+    }
+    else {
+        w->elfGroupsHelped++;
+    }
+
+    if (w->sleighLaunches + w->elfGroupsHelped == w->rounds) {
+        sem_post(w->done); /* Tells main the simulation is over. */
+    }
+
+    return 1;
 }
 
 /*****************************************************************
  *  Thread body. Randomly makes a reindeer get back.             *
  ****************************************************************/
 void* fsanta(void *v) {
-	int i;
+    SantaWorkshop *w = (SantaWorkshop *) v;
+	int attendedReindeer;
+    long wokeAt, signaledAt;
 
-	while (1) {
-        /* Write output. */
-        sem_wait(&lockWrite);
-        santaState = SLEEPING;
-        action = SANTA_SLEPT;
-        writeOutput();
+    traceThread(w->id, "santa", -1);
 
-        sem_wait(&semSanta); /* Santa is initially sleeping. */
+	while (!stopping()) {
+        logEvent(SANTA_SLEPT, -1);
 
-        /* Write state. */
-        sem_wait(&lockWrite);
-        santaState = AWAKE;
-        action = SANTA_WOKE_UP;
-        writeOutput();
+        syncWait(&w->semSanta); /* Santa is initially sleeping. */
+        if (stopping()) {
+            break;
+        }
 
-		sem_wait(&lockCounters); /* Acquire counters lock. */
+        wokeAt = nowNs();
+        logEvent(SANTA_WOKE_UP, -1);
 
-        /* Reindeer has priority over elves. */
-		if (reindeer == N_REINDEER) { /* If all reindeer returned from vacations. */
+        attendedReindeer = 0;
 
-            /* Write output. */
-            sem_wait(&lockWrite);
+        /* Reindeer has priority over elves. Groups stay complete until
+           Santa releases them, so at least one of them is. */
+		if (atomic_load(&w->reindeer) == N_REINDEER) { /* If all reindeer returned from vacations. */
+
+            /* The last reindeer may not have taken the time yet, if Santa
+               was woken up by the elves. */
+            signaledAt = atomic_exchange(&w->reindeerSignaledAt, 0);
+            if (signaledAt) {
+                recordLatency(&w->santaWakeup, wokeAt - signaledAt);
+            }
+            attendedReindeer = 1;
 
-            action = SANTA_ATTENDS_REINDEERS;
-            reindeerWantToBeAttended = 0;
-            writeOutput();
+            logEvent(SANTA_ATTENDS_REINDEERS, -1);
 
             /* Prepares the sleigh. */
             prepareSleigh();
 
-			for (i = 0; i < N_REINDEER ; i++) {
-				sem_post(&semReindeer); /* Wakes all reindeer up. */
-			}
+            w->reindeerReleasedAt = nowNs();
+            gateOpen(&w->gateReindeer); /* Wakes all reindeer up. */
+        }
+		else if (atomic_load(&w->elves) == ELVES_GROUP_SIZE) { /* If there are the minimum number of elves waiting. */
+            attendElves(w, wokeAt);
         }
-		else if (elves == ELVES_GROUP_SIZE) { /* If there are the minimum number of elves waiting. */
 
-            /* Write output. */
-            sem_wait(&lockWrite);
-            action = SANTA_ATTENDS_ELVES;
-            elvesWantToBeAttented = 0;
-            writeOutput();
+        if (!finishRound(w, attendedReindeer)) {
+            break;
+        }
 
-            for (i = 0; i < ELVES_GROUP_SIZE ; i++) {
-                sem_post(&semElf); /* Wakes all elves up. */
+        /* Reindeer may be back before Santa sleeps again, and win every
+           round from then on. So an elf group already waiting is helped
+           right after a delivery, taking the wakeup it posted. */
+        if (attendedReindeer && atomic_load(&w->elves) == ELVES_GROUP_SIZE) {
+            syncWait(&w->semSanta);
+            if (stopping()) {
+                break;
             }
 
-            helpElves(); /* Helps the elves. */
-        }
+            attendElves(w, nowNs());
 
-        sem_post(&lockCounters); /* Release counters lock. */
-        sem_wait(&lockWaitForWork); /* Wait all reindeer to attach or all elves get help so that he can sleep again. */
+            if (!finishRound(w, 0)) {
+                break;
+            }
+        }
 	}
 
 	return NULL;
@@ -0,0 +1,261 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <stdlib.h>
+#include <ucontext.h>
+
+#include "sim.h"
+
+/*****************************************************************
+ *  Definition of coroutines.                                    *
+ ****************************************************************/
+struct coroutine {
+    ucontext_t context;
+    char *stack;
+    void *(*fn)(void *);
+    void *arg;
+    Rng rng; /* Random stream of the entity. */
+    long wakeAt; /* Simulated time it is scheduled to run. */
+    unsigned long order; /* Breaks ties between coroutines scheduled at the same time. */
+    Coroutine *next; /* Next coroutine in the queue it is blocked in. */
+    int finished;
+};
+
+/*****************************************************************
+ *  Global variables initialization.                             *
+ ****************************************************************/
+int simulated = 0;
+unsigned long simSeed = 0;
+
+static ucontext_t scheduler; /* Context of the main thread running the scheduler. */
+static Coroutine *current; /* Coroutine running, NULL in the scheduler. */
+static long now; /* Simulated time, in nanoseconds. */
+static unsigned long nextOrder;
+static long spawned;
+static long switches;
+static unsigned long digest = 14695981039346656037UL;
+
+/* Coroutines scheduled to run, in a binary min heap by time and order. */
+static Coroutine **events;
+static int nEvents, eventsCapacity;
+
+/*****************************************************************
+ *  Random numbers.                                              *
+ ****************************************************************/
+/* Seeds a stream. Seeds are scrambled with splitmix64, so streams
+   of consecutive seeds are unrelated. */
+void seedRng(Rng *rng, unsigned long seed) {
+    seed += 0x9e3779b97f4a7c15UL;
+    seed = (seed ^ (seed >> 30)) * 0xbf58476d1ce4e5b9UL;
+    seed = (seed ^ (seed >> 27)) * 0x94d049bb133111ebUL;
+    seed ^= seed >> 31;
+
+    rng->state = seed ? seed : 1; /* Xorshift never leaves zero. */
+}
+
+/* Returns the next number of a stream. */
+unsigned int nextRng(Rng *rng) {
+    unsigned long x = rng->state;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rng->state = x;
+
+    return (unsigned int) ((x * 2685821657736338717UL) >> 32);
+}
+
+/* Returns the stream of the running coroutine. */
+Rng *simRng() {
+    return &current->rng;
+}
+
+/*****************************************************************
+ *  Event queue.                                                 *
+ ****************************************************************/
+/* Tells whether a coroutine must run before another one. */
+static int before(Coroutine *a, Coroutine *b) {
+    return a->wakeAt < b->wakeAt || (a->wakeAt == b->wakeAt && a->order < b->order);
+}
+
+/* Schedules a coroutine to run at the given simulated time. */
+static void schedule(Coroutine *co, long at) {
+    Coroutine **grown;
+    int i;
+
+    if (nEvents == eventsCapacity) {
+        eventsCapacity = eventsCapacity ? eventsCapacity * 2 : 64;
+        grown = (Coroutine **) realloc(events, sizeof(Coroutine *) * eventsCapacity);
+        if (!grown) {
+            abort(); /* The simulation cannot go on without the coroutine. */
+        }
+        events = grown;
+    }
+
+    co->wakeAt = at;
+    co->order = nextOrder++;
+
+    for (i = nEvents++; i > 0 && before(co, events[(i - 1) / 2]); i = (i - 1) / 2) {
+        events[i] = events[(i - 1) / 2];
+    }
+    events[i] = co;
+}
+
+/* Removes the first coroutine to run from the queue. */
+static Coroutine *nextEvent() {
+    Coroutine *first = events[0], *last = events[--nEvents];
+    int i, child;
+
+    for (i = 0; (child = 2 * i + 1) < nEvents; i = child) {
+        if (child + 1 < nEvents && before(events[child + 1], events[child])) {
+            child++;
+        }
+        if (!before(events[child], last)) {
+            break;
+        }
+        events[i] = events[child];
+    }
+    events[i] = last;
+
+    return first;
+}
+
+/*****************************************************************
+ *  Coroutines.                                                  *
+ ****************************************************************/
+/* First function of every coroutine. */
+static void trampoline() {
+    current->fn(current->arg);
+    current->finished = 1; /* Returns to the scheduler through uc_link. */
+}
+
+/* Creates a coroutine running fn(arg), ready to run at the current
+   simulated time. Its random stream depends only on the seed and on
+   how many coroutines were created before it. Returns 1 on success. */
+int simSpawn(void *(*fn)(void *), void *arg, size_t stackSize) {
+    Coroutine *co = (Coroutine *) calloc(1, sizeof(Coroutine));
+
+    if (!co || !(co->stack = (char *) malloc(stackSize))) {
+        free(co);
+        return 0;
+    }
+
+    getcontext(&co->context);
+    co->context.uc_stack.ss_sp = co->stack;
+    co->context.uc_stack.ss_size = stackSize;
+    co->context.uc_link = &scheduler;
+    makecontext(&co->context, trampoline, 0);
+
+    co->fn = fn;
+    co->arg = arg;
+    seedRng(&co->rng, simSeed + spawned++);
+
+    schedule(co, now);
+
+    return 1;
+}
+
+/* Parks the running coroutine at the end of a queue until simWake. */
+void simBlock(SimQueue *queue) {
+    Coroutine *co = current;
+
+    co->next = NULL;
+    if (queue->tail) {
+        queue->tail->next = co;
+    }
+    else {
+        queue->head = co;
+    }
+    queue->tail = co;
+
+    swapcontext(&co->context, &scheduler);
+}
+
+/* Makes up to n coroutines of a queue ready to run, in the order they
+   blocked. Returns how many there were. */
+int simWake(SimQueue *queue, int n) {
+    Coroutine *co;
+    int woken;
+
+    for (woken = 0; woken < n && queue->head; woken++) {
+        co = queue->head;
+        queue->head = co->next;
+        if (!queue->head) {
+            queue->tail = NULL;
+        }
+
+        schedule(co, now);
+    }
+
+    return woken;
+}
+
+/* Suspends the running coroutine for the given simulated time. */
+void simSleep(long ns) {
+    Coroutine *co = current;
+
+    schedule(co, now + ns);
+    swapcontext(&co->context, &scheduler);
+}
+
+/*****************************************************************
+ *  Scheduler.                                                   *
+ ****************************************************************/
+/* Runs the next scheduled coroutine until it blocks, sleeps or ends.
+   Returns 0 if there is none, or if it is scheduled after the
+   deadline, unless the deadline is 0. */
+int simStep(long deadline) {
+    Coroutine *co;
+
+    if (nEvents == 0 || (deadline > 0 && events[0]->wakeAt > deadline)) {
+        return 0;
+    }
+
+    co = nextEvent();
+    now = co->wakeAt;
+    current = co;
+    switches++;
+
+    swapcontext(&scheduler, &co->context);
+
+    current = NULL;
+    if (co->finished) {
+        free(co->stack);
+        free(co);
+    }
+
+    return 1;
+}
+
+/* Returns the simulated time, in nanoseconds. */
+long simNow() {
+    return now;
+}
+
+/*****************************************************************
+ *  Reproducibility.                                             *
+ ****************************************************************/
+/* Folds an event and its simulated time into the digest of the run
+   (FNV-1a), which is the same for all runs with the same seed. */
+void simDigest(int action, int id) {
+    long values[3];
+    int i;
+
+    values[0] = action;
+    values[1] = id;
+    values[2] = now;
+
+    for (i = 0; i < 3; i++) {
+        digest = (digest ^ (unsigned long) values[i]) * 1099511628211UL;
+    }
+}
+
+/* Returns the digest of all events so far. */
+unsigned long simEventDigest() {
+    return digest;
+}
+
+/* Returns how many times a coroutine was resumed. */
+long simSwitches() {
+    return switches;
+}
@@ -0,0 +1,51 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stddef.h>
+
+/*****************************************************************
+ *  Deterministic simulation.                                    *
+ *                                                               *
+ *  In deterministic mode, Santa, the elves and the reindeer are *
+ *  coroutines run one at a time by a discrete-event scheduler   *
+ *  in the main thread, instead of threads. Waits park the       *
+ *  coroutine in the queue of the semaphore or gate, naps        *
+ *  advance a simulated clock instead of sleeping, and each      *
+ *  entity draws random numbers from its own seeded stream, so   *
+ *  the same seed always gives the same run.                     *
+ ****************************************************************/
+/* Pseudo-random number generator (xorshift64*). */
+typedef struct {
+    unsigned long state;
+} Rng;
+
+typedef struct coroutine Coroutine;
+
+/* FIFO of coroutines blocked in a semaphore or gate. */
+typedef struct {
+    Coroutine *head, *tail;
+} SimQueue;
+
+/*****************************************************************
+ *  Global variables.                                            *
+ ****************************************************************/
+extern int simulated; /* Whether the deterministic mode is on. */
+extern unsigned long simSeed; /* Seed all random streams derive from. */
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+void seedRng(Rng *rng, unsigned long seed);
+unsigned int nextRng(Rng *rng);
+Rng *simRng();
+long simNow();
+int simSpawn(void *(*fn)(void *), void *arg, size_t stackSize);
+void simBlock(SimQueue *queue);
+int simWake(SimQueue *queue, int n);
+void simSleep(long ns);
+int simStep(long deadline);
+void simDigest(int action, int id);
+unsigned long simEventDigest();
+long simSwitches();
+
+#endif /* SIM_H */
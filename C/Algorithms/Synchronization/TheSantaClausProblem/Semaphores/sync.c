@@ -0,0 +1,414 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <limits.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "sync.h"
+
+/*****************************************************************
+ *  Global variables initialization.                             *
+ ****************************************************************/
+/* Backend of all Sync objects. It must not change after the first
+   one is initialized. */
+static SyncBackend backend = SYNC_DEFAULT_BACKEND;
+
+static const char *backendNames[SYNC_BACKENDS] = {"sem", "condvar", "futex", "spin", "sim"};
+
+/* Attempts of the spin backend before parking the thread. */
+#define SPIN_LIMIT 200
+
+/* Hint to the processor that the thread is spinning. */
+#if defined(__x86_64__) || defined(__i386__)
+#define cpuRelax() __builtin_ia32_pause()
+#else
+#define cpuRelax()
+#endif
+
+/*****************************************************************
+ *  Backend selection.                                           *
+ ****************************************************************/
+/* Selects the backend by name. Returns 0 if there is no such backend. */
+int setSyncBackend(const char *name) {
+    int i;
+
+    for (i = 0; i < SYNC_BACKENDS; i++) {
+        if (!strcmp(name, backendNames[i])) {
+            backend = (SyncBackend) i;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Returns the name of the selected backend. */
+const char *syncBackendName() {
+    return backendNames[backend];
+}
+
+/*****************************************************************
+ *  Futex counting semaphore.                                    *
+ *                                                               *
+ *  The counter lives in user space and is taken with a CAS.     *
+ *  Threads only enter the kernel to park when it is zero, and   *
+ *  posts only enter the kernel when someone is parked.          *
+ ****************************************************************/
+static void futexWait(atomic_int *word, int expected) {
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+}
+
+static void futexWake(atomic_int *word, int n) {
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+}
+
+/* Takes one unit of the counter if there is any. */
+static int futexTryWait(Sync *s) {
+    int v = atomic_load(&s->u.futex.value);
+
+    while (v > 0) {
+        if (atomic_compare_exchange_weak(&s->u.futex.value, &v, v - 1)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void futexSemWait(Sync *s, int spins) {
+    int i;
+
+    for (i = 0; i < spins; i++) {
+        if (futexTryWait(s)) {
+            return;
+        }
+        cpuRelax();
+    }
+
+    while (!futexTryWait(s)) {
+        atomic_fetch_add(&s->u.futex.waiters, 1);
+        futexWait(&s->u.futex.value, 0); /* Returns at once if it is not zero anymore. */
+        atomic_fetch_sub(&s->u.futex.waiters, 1);
+    }
+}
+
+static void futexSemPost(Sync *s, int n) {
+    atomic_fetch_add(&s->u.futex.value, n);
+
+    if (atomic_load(&s->u.futex.waiters) > 0) {
+        futexWake(&s->u.futex.value, n);
+    }
+}
+
+/*****************************************************************
+ *  Sync operations.                                             *
+ ****************************************************************/
+/* Initializes a Sync object with the given counter value. The name
+   identifies it in traces. */
+void syncInit(Sync *s, int value, const char *name) {
+#ifdef SANTA_TRACE
+    traceInit(&s->trace, name, value == 1); /* Semaphores starting at 1 are locks. */
+#else
+    (void) name;
+#endif
+
+    switch (backend) {
+        case SYNC_CONDVAR:
+            pthread_mutex_init(&s->u.cv.mutex, NULL);
+            pthread_cond_init(&s->u.cv.cond, NULL);
+            s->u.cv.value = value;
+            break;
+        case SYNC_FUTEX:
+        case SYNC_SPIN:
+            atomic_init(&s->u.futex.value, value);
+            atomic_init(&s->u.futex.waiters, 0);
+            break;
+        case SYNC_SIMULATED:
+            s->u.sim.value = value;
+            s->u.sim.waiters.head = s->u.sim.waiters.tail = NULL;
+            break;
+        default:
+            sem_init(&s->u.sem, 0, value);
+    }
+}
+
+/* Releases the resources of a Sync object. */
+void syncDestroy(Sync *s) {
+    switch (backend) {
+        case SYNC_CONDVAR:
+            pthread_mutex_destroy(&s->u.cv.mutex);
+            pthread_cond_destroy(&s->u.cv.cond);
+            break;
+        case SYNC_FUTEX:
+        case SYNC_SPIN:
+        case SYNC_SIMULATED:
+            break;
+        default:
+            sem_destroy(&s->u.sem);
+    }
+}
+
+/* Decrements the counter, waiting while it is zero. */
+void syncWait(Sync *s) {
+#ifdef SANTA_TRACE
+    long start = traceWaitBegin(&s->trace);
+#endif
+
+    switch (backend) {
+        case SYNC_CONDVAR:
+            pthread_mutex_lock(&s->u.cv.mutex);
+            while (s->u.cv.value == 0) {
+                pthread_cond_wait(&s->u.cv.cond, &s->u.cv.mutex);
+            }
+            s->u.cv.value--;
+            pthread_mutex_unlock(&s->u.cv.mutex);
+            break;
+        case SYNC_FUTEX:
+            futexSemWait(s, 0);
+            break;
+        case SYNC_SPIN:
+            futexSemWait(s, SPIN_LIMIT);
+            break;
+        case SYNC_SIMULATED:
+            while (s->u.sim.value == 0) {
+                simBlock(&s->u.sim.waiters);
+            }
+            s->u.sim.value--;
+            break;
+        default:
+            while (sem_wait(&s->u.sem) == -1); /* Retries if interrupted. */
+    }
+
+#ifdef SANTA_TRACE
+    traceWaitEnd(&s->trace, start);
+#endif
+}
+
+/* Increments the counter, waking up one waiting thread. */
+void syncPost(Sync *s) {
+#ifdef SANTA_TRACE
+    tracePost(&s->trace);
+#endif
+
+    switch (backend) {
+        case SYNC_CONDVAR:
+            pthread_mutex_lock(&s->u.cv.mutex);
+            s->u.cv.value++;
+            pthread_cond_signal(&s->u.cv.cond);
+            pthread_mutex_unlock(&s->u.cv.mutex);
+            break;
+        case SYNC_FUTEX:
+        case SYNC_SPIN:
+            futexSemPost(s, 1);
+            break;
+        case SYNC_SIMULATED:
+            s->u.sim.value++;
+            simWake(&s->u.sim.waiters, 1);
+            break;
+        default:
+            sem_post(&s->u.sem);
+    }
+}
+
+/* Increments the counter by n, waking up to n waiting threads. Except
+   for POSIX semaphores, which can only be posted once per call, it
+   costs a single lock or system call whatever n is. */
+void syncPostMany(Sync *s, int n) {
+    int i;
+
+    if (n <= 0) {
+        return;
+    }
+
+    switch (backend) {
+        case SYNC_CONDVAR:
+            pthread_mutex_lock(&s->u.cv.mutex);
+            s->u.cv.value += n;
+            if (n == 1) {
+                pthread_cond_signal(&s->u.cv.cond);
+            }
+            else {
+                pthread_cond_broadcast(&s->u.cv.cond);
+            }
+            pthread_mutex_unlock(&s->u.cv.mutex);
+            break;
+        case SYNC_FUTEX:
+        case SYNC_SPIN:
+            futexSemPost(s, n);
+            break;
+        case SYNC_SIMULATED:
+            s->u.sim.value += n;
+            simWake(&s->u.sim.waiters, n);
+            break;
+        default:
+            for (i = 0; i < n; i++) {
+                sem_post(&s->u.sem);
+            }
+    }
+}
+
+/*****************************************************************
+ *  Group gates.                                                 *
+ *                                                               *
+ *  Waiters take the current generation with gateEnter before    *
+ *  they are counted, and wait until it changes. The opener only *
+ *  runs once the count is complete, so it cannot open the gate  *
+ *  before every waiter has entered. With futexes, opening is a  *
+ *  single FUTEX_WAKE of all waiters on the generation word, and *
+ *  with condition variables a single broadcast. POSIX           *
+ *  semaphores have no way of waking many threads at once, so    *
+ *  their gates post once per waiter, as the protocol did before *
+ *  gates.                                                       *
+ ****************************************************************/
+/* Initializes a closed gate. The name identifies it in traces. */
+void gateInit(Gate *g, const char *name) {
+#ifdef SANTA_TRACE
+    traceInit(&g->trace, name, 0);
+#else
+    (void) name;
+#endif
+
+    atomic_init(&g->generation, 0);
+    atomic_init(&g->released, 0);
+
+    switch (backend) {
+        case SYNC_CONDVAR:
+            pthread_mutex_init(&g->u.cv.mutex, NULL);
+            pthread_cond_init(&g->u.cv.cond, NULL);
+            break;
+        case SYNC_FUTEX:
+        case SYNC_SPIN:
+            atomic_init(&g->u.futex.waiters, 0);
+            break;
+        case SYNC_SIMULATED:
+            g->u.sim.waiters.head = g->u.sim.waiters.tail = NULL;
+            break;
+        default:
+            sem_init(&g->u.sem.sem, 0, 0);
+            atomic_init(&g->u.sem.waiters, 0);
+    }
+}
+
+/* Releases the resources of a gate. */
+void gateDestroy(Gate *g) {
+    switch (backend) {
+        case SYNC_CONDVAR:
+            pthread_mutex_destroy(&g->u.cv.mutex);
+            pthread_cond_destroy(&g->u.cv.cond);
+            break;
+        case SYNC_FUTEX:
+        case SYNC_SPIN:
+        case SYNC_SIMULATED:
+            break;
+        default:
+            sem_destroy(&g->u.sem.sem);
+    }
+}
+
+/* Joins the group waiting at the gate and returns its generation,
+   to be given to gateWait. It must happen before whatever lets the
+   gate be opened, such as the member being counted, so the opening
+   is never missed. */
+int gateEnter(Gate *g) {
+    if (backend == SYNC_SEMAPHORE) {
+        atomic_fetch_add(&g->u.sem.waiters, 1);
+    }
+
+    return atomic_load(&g->generation);
+}
+
+/* Leaves the group after gateEnter, without waiting. */
+void gateLeave(Gate *g) {
+    if (backend == SYNC_SEMAPHORE) {
+        atomic_fetch_sub(&g->u.sem.waiters, 1);
+    }
+}
+
+/* Waits until the gate is opened for the given generation. */
+void gateWait(Gate *g, int generation) {
+    int i;
+#ifdef SANTA_TRACE
+    long start = traceWaitBegin(&g->trace);
+#endif
+
+    switch (backend) {
+        case SYNC_CONDVAR:
+            pthread_mutex_lock(&g->u.cv.mutex);
+            while (atomic_load(&g->generation) == generation && !atomic_load(&g->released)) {
+                pthread_cond_wait(&g->u.cv.cond, &g->u.cv.mutex);
+            }
+            pthread_mutex_unlock(&g->u.cv.mutex);
+            break;
+        case SYNC_SPIN:
+            for (i = 0; i < SPIN_LIMIT && atomic_load(&g->generation) == generation; i++) {
+                cpuRelax();
+            }
+            /* Falls through to park. */
+        case SYNC_FUTEX:
+            while (atomic_load(&g->generation) == generation && !atomic_load(&g->released)) {
+                atomic_fetch_add(&g->u.futex.waiters, 1);
+                futexWait(&g->generation, generation); /* Returns at once if it changed. */
+                atomic_fetch_sub(&g->u.futex.waiters, 1);
+            }
+            break;
+        case SYNC_SIMULATED:
+            while (atomic_load(&g->generation) == generation && !atomic_load(&g->released)) {
+                simBlock(&g->u.sim.waiters);
+            }
+            break;
+        default:
+            if (!atomic_load(&g->released)) {
+                while (sem_wait(&g->u.sem.sem) == -1); /* Retries if interrupted. */
+            }
+    }
+
+#ifdef SANTA_TRACE
+    traceWaitEnd(&g->trace, start);
+#endif
+}
+
+/* Opens the gate, releasing all threads waiting at it, and closes
+   it again for the next generation. */
+void gateOpen(Gate *g) {
+    int i, n;
+
+    switch (backend) {
+        case SYNC_CONDVAR:
+            pthread_mutex_lock(&g->u.cv.mutex);
+            atomic_fetch_add(&g->generation, 1);
+            pthread_cond_broadcast(&g->u.cv.cond);
+            pthread_mutex_unlock(&g->u.cv.mutex);
+            break;
+        case SYNC_FUTEX:
+        case SYNC_SPIN:
+            atomic_fetch_add(&g->generation, 1);
+            if (atomic_load(&g->u.futex.waiters) > 0) {
+                futexWake(&g->generation, INT_MAX);
+            }
+            break;
+        case SYNC_SIMULATED:
+            atomic_fetch_add(&g->generation, 1);
+            simWake(&g->u.sim.waiters, INT_MAX);
+            break;
+        default:
+            atomic_fetch_add(&g->generation, 1);
+            n = atomic_exchange(&g->u.sem.waiters, 0);
+            for (i = 0; i < n; i++) {
+                sem_post(&g->u.sem.sem);
+            }
+    }
+}
+
+/* Opens the gate for good, so current and future waiters never
+   block at it again. Used to finish the simulation. */
+void gateRelease(Gate *g) {
+    atomic_store(&g->released, 1);
+    gateOpen(g);
+}
@@ -0,0 +1,98 @@
+#ifndef SYNC_H
+#define SYNC_H
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+
+#include "trace.h"
+#include "sim.h"
+
+/*****************************************************************
+ *  Definition of synchronization backends.                      *
+ ****************************************************************/
+/* Primitives a Sync object can be implemented with. */
+typedef enum {
+    SYNC_SEMAPHORE, /* POSIX sem_t. */
+    SYNC_CONDVAR, /* pthread mutex and condition variable guarding a counter. */
+    SYNC_FUTEX, /* Atomic counter, parking on a raw Linux futex. */
+    SYNC_SPIN, /* Same as SYNC_FUTEX, but spins for a while before parking. */
+    SYNC_SIMULATED, /* Queues of the deterministic scheduler, for coroutines only. */
+    SYNC_BACKENDS
+} SyncBackend;
+
+/* Backend used unless another one is selected at run time. It can be
+   changed at build time with -DSYNC_DEFAULT_BACKEND=SYNC_FUTEX, etc. */
+#ifndef SYNC_DEFAULT_BACKEND
+#define SYNC_DEFAULT_BACKEND SYNC_SEMAPHORE
+#endif
+
+/* A counting semaphore, whatever the backend. */
+typedef struct {
+    union {
+        sem_t sem;
+        struct {
+            pthread_mutex_t mutex;
+            pthread_cond_t cond;
+            int value;
+        } cv;
+        struct {
+            atomic_int value;
+            atomic_int waiters;
+        } futex;
+        struct {
+            int value;
+            SimQueue waiters;
+        } sim;
+    } u;
+#ifdef SANTA_TRACE
+    TraceState trace;
+#endif
+} Sync;
+
+/* A gate where a whole group waits to be released at once. Each
+   release opens a new generation, so the gate is closed again for
+   the next group without waiting for the last one to leave. */
+typedef struct {
+    atomic_int generation;
+    atomic_int released; /* Set when the gate must never close again. */
+    union {
+        struct {
+            sem_t sem;
+            atomic_int waiters;
+        } sem;
+        struct {
+            pthread_mutex_t mutex;
+            pthread_cond_t cond;
+        } cv;
+        struct {
+            atomic_int waiters;
+        } futex;
+        struct {
+            SimQueue waiters;
+        } sim;
+    } u;
+#ifdef SANTA_TRACE
+    TraceState trace;
+#endif
+} Gate;
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+int setSyncBackend(const char *name);
+const char *syncBackendName();
+void syncInit(Sync *s, int value, const char *name);
+void syncDestroy(Sync *s);
+void syncWait(Sync *s);
+void syncPost(Sync *s);
+void syncPostMany(Sync *s, int n);
+void gateInit(Gate *g, const char *name);
+void gateDestroy(Gate *g);
+int gateEnter(Gate *g);
+void gateLeave(Gate *g);
+void gateWait(Gate *g, int generation);
+void gateOpen(Gate *g);
+void gateRelease(Gate *g);
+
+#endif /* SYNC_H */
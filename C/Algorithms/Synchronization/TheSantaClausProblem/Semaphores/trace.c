@@ -0,0 +1,252 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#ifdef SANTA_TRACE
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace.h"
+#include "bench.h"
+
+/*****************************************************************
+ *  Definition of trace buffers.                                 *
+ ****************************************************************/
+/* Most semaphores and gates with different names. */
+#define TRACE_POINTS 16
+
+/* Something a thread did, kept in its buffer. */
+typedef struct {
+    TracePoint *point;
+    char type; /* 'W'ait, 'H'old or 'Q'ueue length change. */
+    long start; /* When it started, relative to the trace start. */
+    long value; /* Duration of waits and holds, length of queues. */
+} TraceEvent;
+
+/* Events of one thread. Only the thread itself writes to it, so no
+   synchronization is needed until the trace is exported. */
+typedef struct traceBuffer {
+    TraceEvent *events;
+    long n; /* Events recorded, including overwritten ones. */
+    int pid, tid;
+    char name[32];
+    struct traceBuffer *next;
+} TraceBuffer;
+
+/*****************************************************************
+ *  Global variables initialization.                             *
+ ****************************************************************/
+static TracePoint points[TRACE_POINTS];
+static int nPoints;
+
+static TraceBuffer *buffers; /* All buffers, for exporting. */
+static int nBuffers;
+static pthread_mutex_t registryLock = PTHREAD_MUTEX_INITIALIZER;
+
+static __thread TraceBuffer *buffer; /* Buffer of the calling thread. */
+
+static long origin; /* When tracing started. */
+
+/*****************************************************************
+ *  Registration.                                                *
+ ****************************************************************/
+/* Attaches a semaphore or gate to the point with its name. */
+void traceInit(TraceState *t, const char *name, int lock) {
+    int i;
+
+    pthread_mutex_lock(&registryLock);
+
+    for (i = 0; i < nPoints && strcmp(points[i].name, name); i++);
+
+    if (i == nPoints && nPoints < TRACE_POINTS) {
+        points[nPoints++].name = name;
+    }
+
+    t->point = i < TRACE_POINTS ? &points[i] : NULL;
+    t->lock = lock;
+    atomic_init(&t->waiting, 0);
+    atomic_init(&t->heldSince, 0);
+
+    pthread_mutex_unlock(&registryLock);
+}
+
+/* Gives the calling thread a buffer, named after its role. */
+void traceThread(int workshop, const char *role, int id) {
+    TraceBuffer *b = (TraceBuffer *) calloc(1, sizeof(TraceBuffer));
+
+    if (!b || !(b->events = (TraceEvent *) malloc(sizeof(TraceEvent) * TRACE_BUFFER_EVENTS))) {
+        free(b);
+        return;
+    }
+
+    if (id >= 0) {
+        snprintf(b->name, sizeof(b->name), "%s %d", role, id);
+    }
+    else {
+        snprintf(b->name, sizeof(b->name), "%s", role);
+    }
+    b->pid = workshop;
+
+    pthread_mutex_lock(&registryLock);
+    b->tid = nBuffers++;
+    b->next = buffers;
+    buffers = b;
+    pthread_mutex_unlock(&registryLock);
+
+    buffer = b;
+}
+
+/*****************************************************************
+ *  Recording.                                                   *
+ ****************************************************************/
+/* Appends an event to the calling thread's buffer. */
+static void record(TracePoint *point, char type, long start, long value) {
+    TraceEvent *e;
+
+    if (!buffer) {
+        traceThread(0, "main", -1);
+        if (!buffer) {
+            return;
+        }
+    }
+
+    e = &buffer->events[buffer->n++ % TRACE_BUFFER_EVENTS];
+    e->point = point;
+    e->type = type;
+    e->start = start - origin;
+    e->value = value;
+}
+
+/* Called before blocking. Returns the timestamp to give traceWaitEnd. */
+long traceWaitBegin(TraceState *t) {
+    long now = nowNs();
+    int queued = atomic_fetch_add(&t->waiting, 1);
+
+    if (t->point) {
+        recordLatency(&t->point->queue, queued);
+        record(t->point, 'Q', now, queued + 1);
+    }
+
+    return now;
+}
+
+/* Called after a wait returns. Locks start being held. */
+void traceWaitEnd(TraceState *t, long start) {
+    long now = nowNs();
+    int queued = atomic_fetch_sub(&t->waiting, 1) - 1;
+
+    if (t->point) {
+        recordLatency(&t->point->wait, now - start);
+        record(t->point, 'W', start, now - start);
+        record(t->point, 'Q', now, queued);
+    }
+
+    if (t->lock) {
+        atomic_store(&t->heldSince, now);
+    }
+}
+
+/* Called on each post. Ends the hold of locks. */
+void tracePost(TraceState *t) {
+    long since = atomic_exchange(&t->heldSince, 0);
+    long now;
+
+    if (since && t->point) {
+        now = nowNs();
+        recordLatency(&t->point->hold, now - since);
+        record(t->point, 'H', since, now - since);
+    }
+}
+
+/*****************************************************************
+ *  Output.                                                      *
+ ****************************************************************/
+/* Sets the origin of the timestamps. */
+void traceStart() {
+    origin = nowNs();
+}
+
+/* Prints the percentiles of a histogram, if it has samples. */
+static void printHistogram(const char *point, const char *name, const char *unit, Histogram *h) {
+    if (atomic_load(&h->count) == 0) {
+        return;
+    }
+
+    printf("trace %s %s %s: p50 %ld p90 %ld p99 %ld p99.9 %ld max %ld (%lu samples)\n",
+        point, name, unit, percentile(h, 0.5), percentile(h, 0.9), percentile(h, 0.99),
+        percentile(h, 0.999), atomic_load(&h->max), atomic_load(&h->count));
+}
+
+/* Writes the buffers as Chrome trace events, to be opened in
+   chrome://tracing or ui.perfetto.dev. Returns 1 on success. */
+static int writeChromeTrace(const char *path) {
+    FILE *f = fopen(path, "w");
+    TraceBuffer *b;
+    TraceEvent *e;
+    long i;
+    int first = 1;
+
+    if (!f) {
+        return 0;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    for (b = buffers; b; b = b->next) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",\n", b->pid, b->tid, b->name);
+        first = 0;
+
+        for (i = b->n > TRACE_BUFFER_EVENTS ? b->n - TRACE_BUFFER_EVENTS : 0; i < b->n; i++) {
+            e = &b->events[i % TRACE_BUFFER_EVENTS];
+
+            if (e->type == 'Q') {
+                fprintf(f, ",\n{\"name\":\"queue %s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%d,\"args\":{\"waiting\":%ld}}",
+                    e->point->name, e->start / 1e3, b->pid, e->value);
+            }
+            else {
+                fprintf(f, ",\n{\"name\":\"%s %s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+                    e->type == 'W' ? "wait" : "hold", e->point->name, e->start / 1e3, e->value / 1e3,
+                    b->pid, b->tid);
+            }
+        }
+    }
+
+    fprintf(f, "\n]}\n");
+
+    return fclose(f) == 0;
+}
+
+/* Prints the summary of all points, writes the trace to the given
+   path and releases the buffers. Must be called once all traced
+   threads are gone. */
+void traceFinish(const char *path) {
+    TraceBuffer *b;
+    int i;
+
+    for (i = 0; i < nPoints; i++) {
+        printHistogram(points[i].name, "wait", "ns", &points[i].wait);
+        printHistogram(points[i].name, "hold", "ns", &points[i].hold);
+        printHistogram(points[i].name, "queue", "threads", &points[i].queue);
+    }
+
+    if (writeChromeTrace(path)) {
+        printf("trace written to %s\n", path);
+    }
+    else {
+        fprintf(stderr, "Could not write the trace to %s.\n", path);
+    }
+
+    while (buffers) {
+        b = buffers;
+        buffers = b->next;
+        free(b->events);
+        free(b);
+    }
+    buffer = NULL;
+}
+
+#endif /* SANTA_TRACE */
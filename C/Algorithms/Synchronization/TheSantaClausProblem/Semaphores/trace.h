@@ -0,0 +1,56 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/*****************************************************************
+ *  Tracing of the synchronization protocol.                     *
+ *                                                               *
+ *  Only built with -DSANTA_TRACE (make traced). Otherwise all   *
+ *  functions below are empty macros and Sync objects carry no   *
+ *  tracing fields, so it costs nothing.                         *
+ ****************************************************************/
+#ifdef SANTA_TRACE
+
+#include <stdatomic.h>
+
+#include "bench.h"
+
+/* Events kept per thread. Older ones are overwritten. */
+#define TRACE_BUFFER_EVENTS 16384
+
+/* Statistics of one semaphore or gate, shared by the objects with
+   the same name in all workshops. */
+typedef struct {
+    const char *name;
+    Histogram wait; /* Time blocked in each wait. */
+    Histogram hold; /* Time from a wait to the next post, for locks. */
+    Histogram queue; /* Threads already waiting when a wait started. */
+} TracePoint;
+
+/* Tracing state of a semaphore or gate. */
+typedef struct {
+    TracePoint *point;
+    int lock; /* Whether it is used as a lock, so holds are measured. */
+    atomic_int waiting; /* Threads blocked in it right now. */
+    atomic_long heldSince; /* When the last wait returned, 0 if posted since. */
+} TraceState;
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+void traceInit(TraceState *t, const char *name, int lock);
+void traceThread(int workshop, const char *role, int id);
+long traceWaitBegin(TraceState *t);
+void traceWaitEnd(TraceState *t, long start);
+void tracePost(TraceState *t);
+void traceStart();
+void traceFinish(const char *path);
+
+#else
+
+#define traceThread(workshop, role, id) ((void) 0)
+#define traceStart() ((void) 0)
+#define traceFinish(path) ((void) 0)
+
+#endif /* SANTA_TRACE */
+
+#endif /* TRACE_H */
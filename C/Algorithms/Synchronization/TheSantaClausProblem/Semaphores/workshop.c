@@ -0,0 +1,172 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "workshop.h"
+#include "sync.h"
+#include "sim.h"
+
+#include "reindeer.h"
+#include "santa.h"
+#include "elf.h"
+
+/*****************************************************************
+ *  Workshop lifetime.                                           *
+ ****************************************************************/
+/* Initializes the state of a workshop. Returns 1 on success. */
+int initWorkshop(SantaWorkshop *w, int id, long rounds, sem_t *done) {
+    int i;
+
+    memset(w, 0, sizeof(SantaWorkshop));
+
+    w->id = id;
+    w->rounds = rounds;
+    w->done = done;
+    w->nElfThreads = elfWorkers ? elfWorkers : N_ELVES;
+
+    w->elfHelps = (int *) calloc(N_ELVES, sizeof(int));
+    w->reindeerThreads = (pthread_t *) malloc(sizeof(pthread_t) * N_REINDEER);
+    w->elfThreads = (pthread_t *) malloc(sizeof(pthread_t) * w->nElfThreads);
+    w->reindeerActors = (Actor *) malloc(sizeof(Actor) * N_REINDEER);
+    w->elfActors = (Actor *) malloc(sizeof(Actor) * w->nElfThreads);
+
+    if (!w->elfHelps || !w->reindeerThreads || !w->elfThreads || !w->reindeerActors || !w->elfActors) {
+        return 0;
+    }
+
+    if (elfWorkers && !initElfPool(w)) {
+        return 0;
+    }
+
+    for (i = 0; i < N_REINDEER; i++) {
+        w->reindeerActors[i].workshop = w;
+        w->reindeerActors[i].id = i;
+    }
+    for (i = 0; i < w->nElfThreads; i++) {
+        w->elfActors[i].workshop = w;
+        w->elfActors[i].id = i;
+    }
+
+    /* Semaphore initialization, with the selected primitive. */
+    syncInit(&w->semSanta, 0, "semSanta");
+    syncInit(&w->semDoor, 1, "semDoor");
+    syncInit(&w->lockWaitForWork, 0, "lockWaitForWork");
+    gateInit(&w->gateReindeer, "gateReindeer");
+    gateInit(&w->gateElf, "gateElf");
+    gateInit(&w->gateLastReindeer, "gateLastReindeer");
+
+    return 1;
+}
+
+/* Creates the threads of Santa, the reindeer and the elves, or of
+   the workers impersonating them. In deterministic mode, they are
+   coroutines instead. Returns 1 on success. */
+int startWorkshop(SantaWorkshop *w, pthread_attr_t *attr, size_t stackSize) {
+    int i;
+
+    if (simulated) {
+        if (!simSpawn(fsanta, (void*) w, stackSize)) {
+            return 0;
+        }
+        for (i = 0; i < N_REINDEER; i++) {
+            if (!simSpawn(freindeer, (void*) &w->reindeerActors[i], stackSize)) {
+                return 0;
+            }
+        }
+        for (i = 0; i < w->nElfThreads; i++) {
+            if (!simSpawn(elfWorkers ? felfWorker : felf, (void*) &w->elfActors[i], stackSize)) {
+                return 0;
+            }
+        }
+
+        return 1;
+    }
+
+	/* Creation of Santa's thread. */
+	if (pthread_create(&w->santa, NULL, fsanta, (void*) w)) {
+        fprintf(stderr, "Could not create Santa.\n");
+        return 0;
+    }
+    w->santaStarted = 1;
+
+	/* Creation of reindeer's threads. */
+	for (i = 0; i < N_REINDEER; i++) {
+		if (pthread_create(&w->reindeerThreads[i], attr, freindeer, (void*) &w->reindeerActors[i])) {
+            fprintf(stderr, "Could not create reindeer %d.\n", i);
+            return 0;
+        }
+        w->reindeerStarted++;
+	}
+
+	/* Creation of elves' threads, or of the workers impersonating them. */
+	for (i = 0; i < w->nElfThreads; i++) {
+		if (pthread_create(&w->elfThreads[i], attr, elfWorkers ? felfWorker : felf, (void*) &w->elfActors[i])) {
+            fprintf(stderr, "Could not create elf thread %d.\n", i);
+            return 0;
+        }
+        w->elfStarted++;
+	}
+
+    return 1;
+}
+
+/* Releases every thread of the workshop wherever it is blocked. Each
+   thread checks the stop flag after each wait, so it takes at most
+   one extra post per semaphore per thread. Gates are opened for good. */
+void releaseWorkshop(SantaWorkshop *w) {
+    Sync *semaphores[] = {&w->semSanta, &w->semDoor, &w->lockWaitForWork};
+    int i, n;
+
+    n = w->nElfThreads + N_REINDEER + 1;
+    for (i = 0; i < (int) (sizeof(semaphores) / sizeof(semaphores[0])); i++) {
+        syncPostMany(semaphores[i], n);
+    }
+
+    gateRelease(&w->gateReindeer);
+    gateRelease(&w->gateElf);
+    gateRelease(&w->gateLastReindeer);
+}
+
+/* Waits for all threads the workshop started to finish, which may
+   be only some of them if startWorkshop failed. Coroutines are run
+   to the end by the scheduler. */
+void joinWorkshop(SantaWorkshop *w) {
+    int i;
+
+    if (simulated) {
+        return;
+    }
+
+    if (w->santaStarted) {
+        pthread_join(w->santa, NULL);
+    }
+    for (i = 0; i < w->reindeerStarted; i++) {
+        pthread_join(w->reindeerThreads[i], NULL);
+    }
+    for (i = 0; i < w->elfStarted; i++) {
+        pthread_join(w->elfThreads[i], NULL);
+    }
+}
+
+/* Destroys the semaphores and gates and releases memory once all
+   threads are gone. */
+void freeWorkshop(SantaWorkshop *w) {
+    syncDestroy(&w->semSanta);
+    syncDestroy(&w->semDoor);
+    syncDestroy(&w->lockWaitForWork);
+    gateDestroy(&w->gateReindeer);
+    gateDestroy(&w->gateElf);
+    gateDestroy(&w->gateLastReindeer);
+
+    free(w->elfHelps);
+    free(w->reindeerThreads);
+    free(w->elfThreads);
+    free(w->reindeerActors);
+    free(w->elfActors);
+    freeElfPool(w);
+}
@@ -0,0 +1,88 @@
+#ifndef WORKSHOP_H
+#define WORKSHOP_H
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+
+#include "sync.h"
+#include "bench.h"
+
+/*****************************************************************
+ *  Definition of the workshop.                                  *
+ ****************************************************************/
+/* Size of the cache lines hot fields are aligned to, so fields
+   written by different threads never share one. */
+#define CACHE_LINE_SIZE 64
+#define CACHE_ALIGNED _Alignas(CACHE_LINE_SIZE)
+
+struct santaWorkshop;
+
+/* What an elf or reindeer thread receives: its workshop and its ID. */
+typedef struct {
+    struct santaWorkshop *workshop;
+    int id; /* ID of the elf or reindeer, or of the worker thread. */
+} Actor;
+
+/* All state of one simulation. Several independent workshops can
+   run in the same process. */
+typedef struct santaWorkshop {
+    /* Counters. Arrivals take them with a fetch-and-add, and the one
+       that completes a group signals Santa. */
+    CACHE_ALIGNED atomic_int elves; /* Counter of elves with problems. */
+    CACHE_ALIGNED atomic_int reindeer; /* Counter of reindeer back from vacations. */
+
+    /* Semaphores. */
+    CACHE_ALIGNED Sync semSanta;
+    CACHE_ALIGNED Sync semDoor;
+    CACHE_ALIGNED Sync lockWaitForWork;
+
+    /* Gates where whole groups wait to be released at once. */
+    CACHE_ALIGNED Gate gateReindeer;
+    CACHE_ALIGNED Gate gateElf;
+    CACHE_ALIGNED Gate gateLastReindeer;
+
+    /* Timestamps used for latency statistics. */
+    CACHE_ALIGNED atomic_long elvesSignaledAt; /* When the last elf of a group signaled Santa. */
+    long elvesReleasedAt; /* When Santa released the group. */
+    atomic_long reindeerSignaledAt; /* When the last reindeer signaled Santa. */
+    long reindeerReleasedAt; /* When Santa released the reindeer. */
+
+    /* Statistics. Only Santa writes the round counters. */
+    long elfGroupsHelped;
+    long sleighLaunches;
+    int *elfHelps; /* Times each elf got help. */
+    Histogram santaWakeup; /* Last arrival signal until Santa runs. */
+    Histogram elfWakeup; /* Santa's release until each elf runs. */
+    Histogram reindeerWakeup; /* Santa's release until each reindeer runs. */
+
+    /* Worker pool: FIFO of elves not impersonated by any worker. */
+    CACHE_ALIGNED pthread_mutex_t idleLock;
+    int *idleElves;
+    int idleFront, idleCount;
+
+    /* Threads. */
+    int id;
+    int nElfThreads; /* N_ELVES, or the number of workers. */
+    pthread_t santa;
+    pthread_t *reindeerThreads;
+    pthread_t *elfThreads;
+    int santaStarted, reindeerStarted, elfStarted; /* Threads created, the ones joinWorkshop waits for. */
+    Actor *reindeerActors;
+    Actor *elfActors;
+
+    /* End of the simulation. */
+    long rounds; /* Times Santa must wake up before it ends, 0 if unlimited. */
+    sem_t *done; /* Posted by Santa when the rounds are over. */
+} SantaWorkshop;
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+int initWorkshop(SantaWorkshop *w, int id, long rounds, sem_t *done);
+int startWorkshop(SantaWorkshop *w, pthread_attr_t *attr, size_t stackSize);
+void releaseWorkshop(SantaWorkshop *w);
+void joinWorkshop(SantaWorkshop *w);
+void freeWorkshop(SantaWorkshop *w);
+
+#endif /* WORKSHOP_H */
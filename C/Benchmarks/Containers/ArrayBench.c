@@ -0,0 +1,190 @@
+/*****************************************************************
+ *  Benchmarks of the dynamic array.                             *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "../../DataStructures/DynamicArrays/IndexedArray.h"
+#include "Harness.h"
+#include "Containers.h"
+
+#define CONTAINER "DynamicArray"
+
+/* Times of creating and freeing an array, per pair. */
+#define CREATE_OPS 1000
+
+/* Fills an array with 0, ..., n - 1. Returns 1 on success. */
+static int buildArray(Array *array, long n) {
+    long i;
+
+    if (!createArray(array, n)) {
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        array->info[i] = i;
+    }
+    array->n = n;
+
+    return 1;
+}
+
+/* Fills an indexed array with 0, ..., n - 1. Returns 1 on success. */
+static int buildIndexedArray(IndexedArray *indexed, long n) {
+    long i;
+
+    if (!createIndexedArray(indexed, n)) {
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        insertIndexedArray(indexed, i);
+    }
+
+    return 1;
+}
+
+/* Benchmarks all operations of arrays of n elements. */
+void benchDynamicArray(long n) {
+    Bench b;
+    Array array;
+    IndexedArray indexed;
+    int *keys;
+    long i, ops;
+
+    BENCH(b, CONTAINER, "createArray+freeArray", n) {
+        benchStart(&b);
+        for (i = 0; i < CREATE_OPS; i++) {
+            createArray(&array, n);
+            benchSink += array.size;
+            freeArray(&array);
+        }
+        benchStop(&b, CREATE_OPS);
+    }
+
+    /* Appends from a small array, so it includes all reallocations. */
+    BENCH(b, CONTAINER, "insertArray", n) {
+        if (!createArray(&array, 4)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            insertArray(&array, i);
+        }
+        benchStop(&b, n);
+
+        freeArray(&array);
+    }
+
+    ops = linearOps(n);
+
+    BENCH(b, CONTAINER, "insertArrayAt", n) {
+        if (!buildArray(&array, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            insertArrayAt(&array, i, randomBelow(array.n + 1));
+        }
+        benchStop(&b, ops);
+
+        freeArray(&array);
+    }
+
+    /* Removals by value search for distinct random elements. */
+    BENCH(b, CONTAINER, "removeArray", n) {
+        if (!buildArray(&array, n) || !(keys = randomPermutation(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            removeArray(&array, keys[i]);
+        }
+        benchStop(&b, ops);
+
+        free(keys);
+        freeArray(&array);
+    }
+
+    BENCH(b, CONTAINER, "removeArrayStable", n) {
+        if (!buildArray(&array, n) || !(keys = randomPermutation(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            removeArrayStable(&array, keys[i]);
+        }
+        benchStop(&b, ops);
+
+        free(keys);
+        freeArray(&array);
+    }
+
+    /* The same removals as removeArray, found through the index,
+       until the array is empty. */
+    BENCH(b, CONTAINER, "removeIndexedArray", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        if (!buildIndexedArray(&indexed, n)) {
+            free(keys);
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            removeIndexedArray(&indexed, keys[i]);
+        }
+        benchStop(&b, n);
+
+        free(keys);
+        freeIndexedArray(&indexed);
+    }
+
+    /* Empties the array, so it includes all reallocations. */
+    BENCH(b, CONTAINER, "removeArrayAt", n) {
+        if (!buildArray(&array, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            removeArrayAt(&array, randomBelow(array.n));
+        }
+        benchStop(&b, n);
+
+        freeArray(&array);
+    }
+
+    BENCH(b, CONTAINER, "removeArrayAtStable", n) {
+        if (!buildArray(&array, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            removeArrayAtStable(&array, randomBelow(array.n));
+        }
+        benchStop(&b, ops);
+
+        freeArray(&array);
+    }
+
+    BENCH(b, CONTAINER, "swapElements", n) {
+        if (!buildArray(&array, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            swapElements(&array, randomBelow(n), randomBelow(n));
+        }
+        benchStop(&b, n);
+
+        benchSink += array.info[0];
+        freeArray(&array);
+    }
+}
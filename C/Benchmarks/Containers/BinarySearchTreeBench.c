@@ -0,0 +1,182 @@
+/*****************************************************************
+ *  Benchmarks of the binary search tree. Keys are inserted in   *
+ *  random order, so the tree has logarithmic expected height.   *
+ ****************************************************************/
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../../DataStructures/Trees/BinarySearchTrees/BinarySearchTree.h"
+#include "Harness.h"
+#include "Containers.h"
+
+#define CONTAINER "BinarySearchTree"
+
+/* Builds a tree with the given keys, or NULL if there is no memory. */
+static Node *buildTree(int *keys, long n) {
+    Node *root = NULL, *newNode;
+    long i;
+
+    for (i = 0; i < n; i++) {
+        if (!(newNode = createNode(keys[i]))) {
+            freeTree(root);
+            return NULL;
+        }
+        root = insertNode(root, newNode);
+    }
+
+    return root;
+}
+
+/* Benchmarks all operations of trees of n nodes. */
+void benchBinarySearchTree(long n) {
+    Bench b;
+    Node *root, **results;
+    int *keys;
+    long i;
+
+    BENCH(b, CONTAINER, "insertNode", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        root = NULL;
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            root = insertNode(root, createNode(keys[i]));
+        }
+        benchStop(&b, n);
+
+        freeTree(root);
+        free(keys);
+    }
+
+    /* Finds every key, in an order unrelated to insertion. */
+    BENCH(b, CONTAINER, "findNode", n) {
+        if (!(keys = randomPermutation(n)) || !(root = buildTree(keys, n))) {
+            continue;
+        }
+        free(keys);
+        keys = randomPermutation(n);
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            benchSink += findNode(root, keys[i])->info;
+        }
+        benchStop(&b, n);
+
+        freeTree(root);
+        free(keys);
+    }
+
+    /* The same searches as findNode, in one batch. */
+    BENCH(b, CONTAINER, "findMany", n) {
+        if (!(keys = randomPermutation(n)) || !(root = buildTree(keys, n))) {
+            continue;
+        }
+        free(keys);
+        keys = randomPermutation(n);
+        if (!(results = (Node **) malloc(sizeof(Node *) * n))) {
+            freeTree(root);
+            free(keys);
+            continue;
+        }
+
+        benchStart(&b);
+        findMany(root, keys, n, results);
+        benchStop(&b, n);
+
+        benchSink += results[n - 1]->info;
+        freeTree(root);
+        free(keys);
+        free(results);
+    }
+
+    /* Removes half of the keys, in an order unrelated to insertion. */
+    BENCH(b, CONTAINER, "removeNode", n) {
+        if (!(keys = randomPermutation(n)) || !(root = buildTree(keys, n))) {
+            continue;
+        }
+        free(keys);
+        keys = randomPermutation(n);
+
+        benchStart(&b);
+        for (i = 0; i < n / 2; i++) {
+            root = removeNode(root, keys[i]);
+        }
+        benchStop(&b, n / 2);
+
+        freeTree(root);
+        free(keys);
+    }
+
+    BENCH(b, CONTAINER, "freeTree", n) {
+        if (!(keys = randomPermutation(n)) || !(root = buildTree(keys, n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        freeTree(root);
+        benchStop(&b, n);
+
+        free(keys);
+    }
+}
+
+/* Benchmarks snapshots of trees of n nodes. */
+void benchTreeSnapshot(long n) {
+    Bench b;
+    Node *root, *loaded;
+    Snapshot snapshot;
+    char path[256];
+    int *keys;
+    long i;
+
+    snapshotPath(path, sizeof(path));
+
+    if (!(keys = randomPermutation(n))) {
+        return;
+    }
+    root = buildTree(keys, n);
+    free(keys);
+    if (!root) {
+        return;
+    }
+
+    /* Includes the in-order walk that sorts the keys. */
+    BENCH(b, "Snapshot", "saveTree", n) {
+        benchStart(&b);
+        if (!saveTree(root, path)) {
+            continue;
+        }
+        benchStop(&b, n);
+    }
+
+    /* Builds a balanced tree from the sorted keys. */
+    BENCH(b, "Snapshot", "loadTree", n) {
+        benchStart(&b);
+        if (!loadTree(&loaded, path)) {
+            continue;
+        }
+        benchStop(&b, n);
+
+        freeTree(loaded);
+    }
+
+    /* Searches random keys in the mapped keys, without nodes. */
+    BENCH(b, "Snapshot", "searchSnapshot", n) {
+        if (!mapTree(&snapshot, path, SNAPSHOT_READ_ONLY)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            benchSink += searchSnapshot(&snapshot, randomBelow(n));
+        }
+        benchStop(&b, n);
+
+        unmapSnapshot(&snapshot);
+    }
+
+    freeTree(root);
+    unlink(path);
+}
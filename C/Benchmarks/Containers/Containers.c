@@ -0,0 +1,137 @@
+/*****************************************************************
+ *  Benchmarks every operation of the dynamic array, the binary  *
+ *  heap, the linked lists, the queue, the stack, the binary     *
+ *  search tree, the hash table, the skip list, the key/value    *
+ *  heap and tree templates, the array and list templates and    *
+ *  the static search tree, at sizes growing tenfold, and writes *
+ *  the time per operation, and the hardware counters per        *
+ *  operation when available, as CSV or JSON. compare.sh         *
+ *  compares two runs.                                           *
+ ****************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Harness.h"
+#include "Containers.h"
+
+/* Benchmarks of each container. */
+static void (*const suites[])(long n) = {
+    benchDynamicArray,
+    benchBinaryHeap,
+    benchSinglyLinkedList,
+    benchDoublyLinkedList,
+    benchQueue,
+    benchStack,
+    benchBinarySearchTree,
+    benchHashTable,
+    benchSkipList,
+    benchKeyValueHeap,
+    benchKeyValueTree,
+    benchArrayTemplate,
+    benchListTemplate,
+    benchArraySnapshot,
+    benchTreeSnapshot,
+};
+
+/* Benchmarks that run above SIZE_LIMIT too. */
+static void (*const largeSuites[])(long n) = {
+    benchStaticSearchTree,
+};
+
+/* Prints the command line options. */
+void usage(char *program) {
+    fprintf(stderr, "Usage: %s [-n min_size] [-N max_size] [-r repetitions] [-w warmups]\n"
+        "          [-m match] [-f csv|json] [-o file] [-c]\n"
+        "  -n  smallest size (default 1000)\n"
+        "  -N  largest size, up to 1000000000 (default 1000000)\n"
+        "  -r  measured runs of each benchmark (default %d)\n"
+        "  -w  warm-up runs of each benchmark (default %d)\n"
+        "  -m  only benchmarks whose container/operation contains this text\n"
+        "  -f  output format (default csv)\n"
+        "  -o  output file (default standard output)\n"
+        "  -c  do not read the hardware counters\n",
+        program, repetitions, warmups);
+}
+
+int main(int argc, char *argv[]) {
+    long n, minN = 1000, maxN = 1000000;
+    Format format = CSV;
+    FILE *out = stdout;
+    int opt, counting = 1;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "n:N:r:w:m:f:o:c")) != -1) {
+        switch (opt) {
+            case 'n':
+                minN = atol(optarg);
+                break;
+            case 'N':
+                maxN = atol(optarg);
+                break;
+            case 'r':
+                repetitions = atoi(optarg);
+                break;
+            case 'w':
+                warmups = atoi(optarg);
+                break;
+            case 'm':
+                match = optarg;
+                break;
+            case 'f':
+                if (!strcmp(optarg, "csv")) {
+                    format = CSV;
+                }
+                else if (!strcmp(optarg, "json")) {
+                    format = JSON;
+                }
+                else {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'o':
+                if (!(out = fopen(optarg, "w"))) {
+                    perror(optarg);
+                    return 1;
+                }
+                break;
+            case 'c':
+                counting = 0;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (minN < 1 || maxN < minN || maxN > 1000000000 || repetitions < 1 || warmups < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (counting) {
+        openCounters();
+    }
+
+    openResults(out, format);
+
+    for (n = minN; n <= maxN; n *= 10) {
+        for (i = 0; n <= SIZE_LIMIT && i < sizeof(suites) / sizeof(suites[0]); i++) {
+            suites[i](n);
+        }
+        for (i = 0; i < sizeof(largeSuites) / sizeof(largeSuites[0]); i++) {
+            largeSuites[i](n);
+        }
+    }
+
+    closeResults();
+    closeCounters();
+
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+#ifndef CONTAINERS_H
+#define CONTAINERS_H
+
+#include <stddef.h>
+
+/*****************************************************************
+ *  Benchmarks of each container, for a given size.              *
+ ****************************************************************/
+void benchDynamicArray(long n);
+void benchBinaryHeap(long n);
+void benchSinglyLinkedList(long n);
+void benchDoublyLinkedList(long n);
+void benchQueue(long n);
+void benchStack(long n);
+void benchBinarySearchTree(long n);
+void benchHashTable(long n);
+void benchSkipList(long n);
+void benchKeyValueHeap(long n);
+void benchKeyValueTree(long n);
+void benchArrayTemplate(long n);
+void benchListTemplate(long n);
+void benchArraySnapshot(long n);
+void benchTreeSnapshot(long n);
+void benchStaticSearchTree(long n);
+
+/* Containers other than the static search tree need tens of bytes
+   per element, so they only run up to this size. */
+#define SIZE_LIMIT 100000000
+
+/* Recursive operations use one stack frame per node, so they only
+   run up to this size. */
+#define RECURSION_LIMIT 100000
+
+/* Writes the name of the temporary file snapshots are saved to. */
+void snapshotPath(char *path, size_t size);
+
+#endif /* CONTAINERS_H */
@@ -0,0 +1,168 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Counters.h"
+
+/*****************************************************************
+ *  Global variables initialization.                             *
+ ****************************************************************/
+const char *const counterNames[N_COUNTERS] = {
+    "cycles",
+    "instructions",
+    "l1d_misses",
+    "llc_misses",
+    "branch_misses",
+    "dtlb_misses",
+};
+
+#ifdef __linux__
+/* Event of each counter. */
+#define CACHE_READ_MISSES(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const struct {
+    unsigned int type;
+    unsigned long config;
+} events[N_COUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISSES(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISSES(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISSES(PERF_COUNT_HW_CACHE_DTLB)},
+};
+
+/* File descriptor of each counter, -1 if it is not open. */
+static int counters[N_COUNTERS] = {-1, -1, -1, -1, -1, -1};
+
+/* Reading of each counter when counting started: count, time
+   enabled and time running. Resetting a counter only zeroes its
+   count, so the times since it was opened are subtracted too. */
+static unsigned long started[N_COUNTERS][3];
+#endif
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+/* Opens the counters the system supports, and tells on the standard
+   error why the others are missing. Each counter is opened on its
+   own, so the kernel multiplexes them if there are more counters
+   than registers, and the counts are scaled to the time they ran
+   during each region (see stopCounters).
+   Returns how many are open. */
+int openCounters() {
+    int opened = 0;
+#ifdef __linux__
+    struct perf_event_attr attr;
+    int i, error[N_COUNTERS];
+
+    for (i = 0; i < N_COUNTERS; i++) {
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = events[i].type;
+        attr.config = events[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        counters[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        error[i] = counters[i] < 0 ? errno : 0;
+        if (counters[i] >= 0) {
+            opened++;
+        }
+    }
+
+    if (opened == 0) {
+        fprintf(stderr, "Hardware counters are not available (%s), only times are reported.\n",
+            strerror(error[0]));
+    }
+    else {
+        for (i = 0; i < N_COUNTERS; i++) {
+            if (error[i]) {
+                fprintf(stderr, "Counter %s is not available: %s.\n", counterNames[i], strerror(error[i]));
+            }
+        }
+    }
+#else
+    fprintf(stderr, "Hardware counters are only available on Linux, only times are reported.\n");
+#endif
+
+    return opened;
+}
+
+/* Closes all counters. */
+void closeCounters() {
+#ifdef __linux__
+    int i;
+
+    for (i = 0; i < N_COUNTERS; i++) {
+        if (counters[i] >= 0) {
+            close(counters[i]);
+            counters[i] = -1;
+        }
+    }
+#endif
+}
+
+/* Reads the open counters and starts counting. */
+void startCounters() {
+#ifdef __linux__
+    int i;
+
+    for (i = 0; i < N_COUNTERS; i++) {
+        if (counters[i] >= 0) {
+            if (read(counters[i], started[i], sizeof(started[i])) != sizeof(started[i])) {
+                started[i][0] = started[i][1] = started[i][2] = 0;
+            }
+            ioctl(counters[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+/* Stops counting and stores the count of each counter since
+   startCounters in values, or -1 if it is not open or never ran.
+   When the kernel multiplexed a counter, its count is scaled by the
+   time it was enabled over the time it ran, both since
+   startCounters. */
+void stopCounters(double *values) {
+    int i;
+#ifdef __linux__
+    unsigned long reading[3]; /* Count, time enabled and time running. */
+    unsigned long running;
+
+    for (i = 0; i < N_COUNTERS; i++) {
+        if (counters[i] >= 0) {
+            ioctl(counters[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (i = 0; i < N_COUNTERS; i++) {
+        values[i] = -1;
+        if (counters[i] < 0 || read(counters[i], reading, sizeof(reading)) != sizeof(reading)) {
+            continue;
+        }
+
+        running = reading[2] - started[i][2];
+        if (running > 0) {
+            values[i] = (double) (reading[0] - started[i][0]) * (reading[1] - started[i][1]) / running;
+        }
+    }
+#else
+    for (i = 0; i < N_COUNTERS; i++) {
+        values[i] = -1;
+    }
+#endif
+}
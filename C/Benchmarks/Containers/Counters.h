@@ -0,0 +1,35 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+/*****************************************************************
+ *  Hardware performance counters.                               *
+ *                                                               *
+ *  On Linux, the counters below are read with perf_event_open   *
+ *  around each timed region, counting only the benchmark        *
+ *  process in user mode. A counter that cannot be opened, for   *
+ *  example on other systems, in containers, in virtual machines *
+ *  without a virtual PMU or when perf_event_paranoid forbids    *
+ *  it, reads as -1 and the benchmark only reports times.        *
+ ****************************************************************/
+typedef enum {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES, /* L1 data cache read misses. */
+    LLC_MISSES, /* Last level cache read misses. */
+    BRANCH_MISSES,
+    DTLB_MISSES, /* Data TLB read misses. */
+    N_COUNTERS
+} Counter;
+
+/* Names of the counters, as they appear in the results. */
+extern const char *const counterNames[N_COUNTERS];
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+int openCounters();
+void closeCounters();
+void startCounters();
+void stopCounters(double *values);
+
+#endif /* COUNTERS_H */
@@ -0,0 +1,9 @@
+/*****************************************************************
+ *  Benchmarks of the doubly linked list.                        *
+ ****************************************************************/
+#include "../../DataStructures/LinkedLists/DoublyLinkedLists/DoublyLinkedList.h"
+
+#define CONTAINER "DoublyLinkedList"
+#define BENCH_LIST benchDoublyLinkedList
+
+#include "LinkedListBench.h"
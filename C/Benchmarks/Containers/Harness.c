@@ -0,0 +1,293 @@
+/*****************************************************************
+ *  Libraries import.                                            *
+ ****************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Harness.h"
+
+/*****************************************************************
+ *  Global variables initialization.                             *
+ ****************************************************************/
+int warmups = 1;
+int repetitions = 5;
+const char *match = NULL;
+volatile long benchSink;
+
+/* Total amount of elements visited by the timed region of an
+   operation that walks the container, such as a search in a list. */
+#define LINEAR_WORK 20000000L
+#define MAX_LINEAR_OPS 1000
+
+static FILE *results;
+static Format resultsFormat;
+static int nResults;
+static unsigned long randomState = 1;
+
+/*****************************************************************
+ *  Auxiliary functions.                                         *
+ ****************************************************************/
+/* Returns a monotonic timestamp in nanoseconds. */
+static long now() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/* Compares two doubles, for qsort. */
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+/* Sorts m values and returns their median. */
+static double median(double *values, int m) {
+    qsort(values, m, sizeof(double), compareDoubles);
+
+    return m % 2 ? values[m / 2] : (values[m / 2 - 1] + values[m / 2]) / 2;
+}
+
+/* Writes the statistics of a finished benchmark. Counters missing in
+   any repetition are left empty in CSV and null in JSON. */
+static void report(Bench *b) {
+    double min, middle, mean = 0, variance = 0, *counts;
+    int i, c, m = repetitions;
+
+    middle = median(b->samples, m);
+    min = b->samples[0];
+
+    for (i = 0; i < m; i++) {
+        mean += b->samples[i];
+    }
+    mean /= m;
+
+    for (i = 0; i < m; i++) {
+        variance += (b->samples[i] - mean) * (b->samples[i] - mean);
+    }
+    variance = m > 1 ? variance / (m - 1) : 0;
+
+    if (resultsFormat == CSV) {
+        fprintf(results, "%s,%s,%ld,%ld,%d,%.3f,%.3f,%.3f,%.3f",
+            b->container, b->operation, b->n, b->ops, m, min, middle, mean, sqrt(variance));
+    }
+    else {
+        fprintf(results, "%s\n  {\"container\": \"%s\", \"operation\": \"%s\", \"n\": %ld, "
+            "\"ops\": %ld, \"repetitions\": %d, \"min_ns\": %.3f, \"median_ns\": %.3f, "
+            "\"mean_ns\": %.3f, \"stddev_ns\": %.3f",
+            nResults ? "," : "", b->container, b->operation, b->n, b->ops, m,
+            min, middle, mean, sqrt(variance));
+    }
+
+    for (c = 0; c < N_COUNTERS; c++) {
+        counts = b->counts + c * m;
+        for (i = 0; i < m && counts[i] >= 0; i++);
+
+        if (resultsFormat == CSV) {
+            if (i == m) {
+                fprintf(results, ",%.3f", median(counts, m));
+            }
+            else {
+                fprintf(results, ",");
+            }
+        }
+        else {
+            if (i == m) {
+                fprintf(results, ", \"%s\": %.3f", counterNames[c], median(counts, m));
+            }
+            else {
+                fprintf(results, ", \"%s\": null", counterNames[c]);
+            }
+        }
+    }
+
+    fprintf(results, resultsFormat == CSV ? "\n" : "}");
+
+    fflush(results);
+    nResults++;
+}
+
+/*****************************************************************
+ *  Results.                                                     *
+ ****************************************************************/
+/* Starts writing results to the given file. */
+void openResults(FILE *out, Format format) {
+    int c;
+
+    results = out;
+    resultsFormat = format;
+    nResults = 0;
+
+    if (format == CSV) {
+        fprintf(results, "container,operation,n,ops,repetitions,min_ns,median_ns,mean_ns,stddev_ns");
+        for (c = 0; c < N_COUNTERS; c++) {
+            fprintf(results, ",%s", counterNames[c]);
+        }
+        fprintf(results, "\n");
+    }
+    else {
+        fprintf(results, "[");
+    }
+}
+
+/* Finishes the results. */
+void closeResults() {
+    if (resultsFormat == JSON) {
+        fprintf(results, "\n]\n");
+    }
+    fflush(results);
+}
+
+/*****************************************************************
+ *  Benchmarks.                                                  *
+ ****************************************************************/
+/* Prepares a benchmark of an operation on a container of size n. */
+void benchInit(Bench *b, const char *container, const char *operation, long n) {
+    char name[128];
+    int i;
+
+    b->container = container;
+    b->operation = operation;
+    b->n = n;
+    b->ops = 0;
+    b->samples = NULL;
+    b->counts = NULL;
+
+    snprintf(name, sizeof(name), "%s/%s", container, operation);
+    if (match && !strstr(name, match)) {
+        b->run = warmups + repetitions; /* Filtered out: nothing runs. */
+        return;
+    }
+
+    b->samples = (double *) malloc(sizeof(double) * repetitions);
+    b->counts = (double *) malloc(sizeof(double) * repetitions * N_COUNTERS);
+    if (!b->samples || !b->counts) {
+        fprintf(stderr, "Could not allocate memory for %s.\n", name);
+        free(b->samples);
+        free(b->counts);
+        b->samples = b->counts = NULL;
+        b->run = warmups + repetitions;
+        return;
+    }
+
+    for (i = 0; i < repetitions; i++) {
+        b->samples[i] = -1; /* Not timed yet. */
+    }
+    for (i = 0; i < repetitions * N_COUNTERS; i++) {
+        b->counts[i] = -1;
+    }
+
+    b->run = 0;
+}
+
+/* Tells whether there is another run to do. After the last one,
+   reports the results, unless some run could not be timed. */
+int benchNext(Bench *b) {
+    int i;
+
+    if (b->run < warmups + repetitions) {
+        b->run++;
+        seedRandom(b->n); /* Every run sees the same data. */
+
+        return 1;
+    }
+
+    if (b->samples) {
+        for (i = 0; i < repetitions && b->samples[i] >= 0; i++);
+
+        if (i == repetitions) {
+            report(b);
+        }
+        else {
+            fprintf(stderr, "Skipped %s/%s with n = %ld.\n", b->container, b->operation, b->n);
+        }
+
+        free(b->samples);
+        free(b->counts);
+        b->samples = b->counts = NULL;
+    }
+
+    return 0;
+}
+
+/* Starts the timed region of the current run. */
+void benchStart(Bench *b) {
+    startCounters();
+    b->start = now();
+}
+
+/* Ends the timed region of the current run, which did the given
+   amount of operations. */
+void benchStop(Bench *b, long ops) {
+    long elapsed = now() - b->start;
+    double values[N_COUNTERS];
+    long divisor = ops > 0 ? ops : 1;
+    int r = b->run - warmups - 1, c;
+
+    stopCounters(values);
+
+    if (r >= 0) {
+        b->samples[r] = (double) elapsed / divisor;
+        for (c = 0; c < N_COUNTERS; c++) {
+            b->counts[c * repetitions + r] = values[c] < 0 ? -1 : values[c] / divisor;
+        }
+    }
+
+    b->ops = ops;
+}
+
+/* Returns how many operations to time on a container of size n when
+   each one takes time proportional to n, so large sizes finish. They
+   are at most a tenth of n, so removals barely shrink the container. */
+long linearOps(long n) {
+    long ops = LINEAR_WORK / n, max = n / 10 < MAX_LINEAR_OPS ? n / 10 : MAX_LINEAR_OPS;
+
+    return ops > max ? max : ops < 1 ? 1 : ops;
+}
+
+/*****************************************************************
+ *  Random numbers.                                              *
+ ****************************************************************/
+/* Seeds the generator (xorshift64*). */
+void seedRandom(unsigned long seed) {
+    randomState = seed * 0x9e3779b97f4a7c15UL + 1;
+}
+
+/* Returns a random number in [0, bound). */
+unsigned int randomBelow(unsigned int bound) {
+    randomState ^= randomState >> 12;
+    randomState ^= randomState << 25;
+    randomState ^= randomState >> 27;
+
+    return (unsigned int) (((randomState * 2685821657736338717UL) >> 32) % bound);
+}
+
+/* Returns a random permutation of 0, ..., n - 1, to be freed by the
+   caller, or NULL if there is no memory. */
+int *randomPermutation(long n) {
+    int *keys = (int *) malloc(sizeof(int) * n);
+    long i, j;
+    int aux;
+
+    if (!keys) {
+        return NULL;
+    }
+
+    for (i = 0; i < n; i++) {
+        keys[i] = i;
+    }
+
+    for (i = n - 1; i > 0; i--) {
+        j = randomBelow(i + 1);
+        aux = keys[i];
+        keys[i] = keys[j];
+        keys[j] = aux;
+    }
+
+    return keys;
+}
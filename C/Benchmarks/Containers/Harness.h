@@ -0,0 +1,75 @@
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include <stdio.h>
+
+#include "Counters.h"
+
+/*****************************************************************
+ *  Microbenchmark harness.                                      *
+ *                                                               *
+ *  Each benchmark times a region doing ops operations on a      *
+ *  container of size n, after some warm-up runs, a number of    *
+ *  times, and reports statistics of the time per operation:     *
+ *                                                               *
+ *      BENCH(b, "Stack", "pushStack", n) {                      *
+ *          createStack(&s);                                     *
+ *          benchStart(&b);                                      *
+ *          for (i = 0; i < n; i++) {                            *
+ *              pushStack(&s, i);                                *
+ *          }                                                    *
+ *          benchStop(&b, n);                                    *
+ *          freeStack(&s);                                       *
+ *      }                                                        *
+ *                                                               *
+ *  Only the region between benchStart and benchStop is timed,   *
+ *  so each run can build and release its containers. The open   *
+ *  hardware counters (see Counters.h) count the same region,    *
+ *  and their medians per operation are reported too.            *
+ ****************************************************************/
+typedef struct {
+    const char *container;
+    const char *operation;
+    long n; /* Size of the container. */
+    long ops; /* Operations per timed region. */
+    int run; /* Current run, counting warm-up runs. */
+    long start; /* When the timed region started. */
+    double *samples; /* Nanoseconds per operation of each repetition. */
+    double *counts; /* Events per operation of each counter and repetition, -1 if not counted. */
+} Bench;
+
+/* Output formats. */
+typedef enum {
+    CSV,
+    JSON
+} Format;
+
+/*****************************************************************
+ *  Settings.                                                    *
+ ****************************************************************/
+extern int warmups; /* Runs before the measured ones. */
+extern int repetitions; /* Measured runs. */
+extern const char *match; /* Only "container/operation" names containing it run. */
+
+/* Keeps the compiler from discarding the measured loops. */
+extern volatile long benchSink;
+
+/*****************************************************************
+ *  Functions.                                                   *
+ ****************************************************************/
+void openResults(FILE *out, Format format);
+void closeResults();
+void benchInit(Bench *b, const char *container, const char *operation, long n);
+int benchNext(Bench *b);
+void benchStart(Bench *b);
+void benchStop(Bench *b, long ops);
+long linearOps(long n);
+void seedRandom(unsigned long seed);
+unsigned int randomBelow(unsigned int bound);
+int *randomPermutation(long n);
+
+/* Runs the block after it as many times as the benchmark needs. */
+#define BENCH(b, container, operation, n) \
+    for (benchInit(&(b), (container), (operation), (n)); benchNext(&(b)); )
+
+#endif /* HARNESS_H */
@@ -0,0 +1,137 @@
+/*****************************************************************
+ *  Benchmarks of the Robin Hood hash table. Keys are inserted   *
+ *  in random order, and searched keys are random numbers below  *
+ *  2n, so half of them are found.                               *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "../../DataStructures/HashTables/RobinHood/HashTable.h"
+#include "Harness.h"
+#include "Containers.h"
+
+#define CONTAINER "HashTable"
+
+/* Fills a table with the keys 0 to n - 1, in random order. Returns 1
+   on success. */
+static int buildTable(HashTable *table, long n) {
+    int *keys;
+    long i;
+
+    if (!(keys = randomPermutation(n))) {
+        return 0;
+    }
+    if (!createHashTable(table, n, HASH_TABLE_DEFAULT_LOAD_FACTOR)) {
+        free(keys);
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        insertHashTable(table, keys[i], i);
+    }
+
+    free(keys);
+    return 1;
+}
+
+/* Returns n random keys below 2n, or NULL if there is no memory. */
+static int *randomQueries(long n) {
+    int *queries = (int *) malloc(sizeof(int) * n);
+    long i;
+
+    for (i = 0; queries && i < n; i++) {
+        queries[i] = randomBelow(2 * n);
+    }
+
+    return queries;
+}
+
+/* Benchmarks all operations of tables of n keys. */
+void benchHashTable(long n) {
+    Bench b;
+    HashTable table;
+    int *keys, *found, *values, value;
+    long i;
+
+    /* Starts small, so it includes all resizes. */
+    BENCH(b, CONTAINER, "insertHashTable", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        if (!createHashTable(&table, 0, HASH_TABLE_DEFAULT_LOAD_FACTOR)) {
+            free(keys);
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            insertHashTable(&table, keys[i], i);
+        }
+        benchStop(&b, n);
+
+        freeHashTable(&table);
+        free(keys);
+    }
+
+    BENCH(b, CONTAINER, "findHashTable", n) {
+        if (!(keys = randomQueries(n))) {
+            continue;
+        }
+        if (!buildTable(&table, n)) {
+            free(keys);
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            if (findHashTable(&table, keys[i], &value)) {
+                benchSink += value;
+            }
+        }
+        benchStop(&b, n);
+
+        freeHashTable(&table);
+        free(keys);
+    }
+
+    /* The same searches as findHashTable, in one batch. */
+    BENCH(b, CONTAINER, "findManyHashTable", n) {
+        keys = randomQueries(n);
+        found = (int *) malloc(sizeof(int) * n);
+        values = (int *) malloc(sizeof(int) * n);
+        if (!keys || !found || !values || !buildTable(&table, n)) {
+            free(keys);
+            free(found);
+            free(values);
+            continue;
+        }
+
+        benchStart(&b);
+        benchSink += findManyHashTable(&table, keys, n, found, values);
+        benchStop(&b, n);
+
+        freeHashTable(&table);
+        free(keys);
+        free(found);
+        free(values);
+    }
+
+    /* Erases half of the keys, in an order unrelated to insertion. */
+    BENCH(b, CONTAINER, "eraseHashTable", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        if (!buildTable(&table, n)) {
+            free(keys);
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n / 2; i++) {
+            eraseHashTable(&table, keys[i]);
+        }
+        benchStop(&b, n / 2);
+
+        freeHashTable(&table);
+        free(keys);
+    }
+}
@@ -0,0 +1,132 @@
+/*****************************************************************
+ *  Benchmarks of the binary (max) heap.                         *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "../../DataStructures/Heaps/BinaryHeaps/Heap.h"
+#include "Harness.h"
+#include "Containers.h"
+
+#define CONTAINER "BinaryHeap"
+
+/* Times of creating and freeing a heap, per pair. */
+#define CREATE_OPS 1000
+
+/* Fills a heap with n random elements. Returns 1 on success. */
+static int buildHeap(Heap *heap, long n) {
+    long i;
+
+    if (!createHeap(heap, n)) {
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        insertHeap(heap, randomBelow(n));
+    }
+
+    return 1;
+}
+
+/* Benchmarks all operations of heaps of n elements. */
+void benchBinaryHeap(long n) {
+    Bench b;
+    Heap heap;
+    int *keys, top;
+    long i, ops;
+
+    BENCH(b, CONTAINER, "createHeap+freeHeap", n) {
+        benchStart(&b);
+        for (i = 0; i < CREATE_OPS; i++) {
+            createHeap(&heap, n);
+            benchSink += heap.size;
+            freeHeap(&heap);
+        }
+        benchStop(&b, CREATE_OPS);
+    }
+
+    BENCH(b, CONTAINER, "insertHeap", n) {
+        if (!createHeap(&heap, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            insertHeap(&heap, randomBelow(n));
+        }
+        benchStop(&b, n);
+
+        freeHeap(&heap);
+    }
+
+    /* Empties the heap, so it includes all reallocations. */
+    BENCH(b, CONTAINER, "extractHeap", n) {
+        if (!buildHeap(&heap, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            extractHeap(&heap, &top);
+            benchSink += top;
+        }
+        benchStop(&b, n);
+
+        freeHeap(&heap);
+    }
+
+    /* Removals by value search for distinct random elements. */
+    ops = linearOps(n);
+    BENCH(b, CONTAINER, "removeHeap", n) {
+        if (!createHeap(&heap, n) || !(keys = randomPermutation(n))) {
+            continue;
+        }
+        for (i = 0; i < n; i++) {
+            insertHeap(&heap, keys[i]);
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            removeHeap(&heap, keys[n - 1 - i]);
+        }
+        benchStop(&b, ops);
+
+        free(keys);
+        freeHeap(&heap);
+    }
+
+    /* Raises random elements above the top, so each one goes up the
+       whole path to the root. */
+    BENCH(b, CONTAINER, "fixUpHeap", n) {
+        if (!buildHeap(&heap, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            top = 1 + randomBelow(heap.n);
+            heap.info[top] = heap.info[1] + 1;
+            fixUpHeap(&heap, top);
+        }
+        benchStop(&b, n);
+
+        freeHeap(&heap);
+    }
+
+    /* Lowers random elements below the bottom, so each one goes down
+       the whole path to a leaf. */
+    BENCH(b, CONTAINER, "fixDownHeap", n) {
+        if (!buildHeap(&heap, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            top = 1 + randomBelow(heap.n);
+            heap.info[top] = -1 - i;
+            fixDownHeap(&heap, top);
+        }
+        benchStop(&b, n);
+
+        freeHeap(&heap);
+    }
+}
@@ -0,0 +1,246 @@
+/*****************************************************************
+ *  Benchmarks of the key/value heap and binary search tree      *
+ *  templates, with int keys and 24-byte values stored along     *
+ *  them. The heap is a max heap, as BinaryHeap, and keys are    *
+ *  inserted in random order, as in BinarySearchTree, so their   *
+ *  times compare to the ones of the int structures.             *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "../../DataStructures/Heaps/BinaryHeaps/HeapTemplate.h"
+#include "../../DataStructures/Trees/BinarySearchTrees/BinarySearchTreeTemplate.h"
+#include "Harness.h"
+#include "Containers.h"
+
+/* Value associated to each key. */
+typedef struct {
+    long id;
+    double weight;
+    char tag[8];
+} Payload;
+
+DEFINE_HEAP(int, Payload, ADS_COMPARE)
+DEFINE_BST(int, Payload, ADS_COMPARE)
+
+/* Returns the value stored with a key. */
+static Payload payloadOf(int key) {
+    Payload value = {key, key * 0.5, "payload"};
+
+    return value;
+}
+
+/*****************************************************************
+ *  Heap.                                                        *
+ ****************************************************************/
+/* Fills a heap with n random elements. Returns 1 on success. */
+static int buildHeap(Heap_int_Payload *heap, long n) {
+    long i;
+    int key;
+
+    if (!createHeap_int_Payload(heap, n)) {
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        key = randomBelow(n);
+        insertHeap_int_Payload(heap, key, payloadOf(key));
+    }
+
+    return 1;
+}
+
+/* Benchmarks all operations of heaps of n elements. */
+void benchKeyValueHeap(long n) {
+    Bench b;
+    Heap_int_Payload heap;
+    Payload value = payloadOf(0);
+    int key = 0, k;
+    long i;
+
+    BENCH(b, "KeyValueHeap", "insertHeap", n) {
+        if (!createHeap_int_Payload(&heap, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            key = randomBelow(n);
+            insertHeap_int_Payload(&heap, key, payloadOf(key));
+        }
+        benchStop(&b, n);
+
+        freeHeap_int_Payload(&heap);
+    }
+
+    /* Empties the heap, so it includes all reallocations. */
+    BENCH(b, "KeyValueHeap", "extractHeap", n) {
+        if (!buildHeap(&heap, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            extractHeap_int_Payload(&heap, &key, &value);
+            benchSink += key + value.id;
+        }
+        benchStop(&b, n);
+
+        freeHeap_int_Payload(&heap);
+    }
+
+    /* Removes random positions, half of the heap. */
+    BENCH(b, "KeyValueHeap", "removeHeapAt", n) {
+        if (!buildHeap(&heap, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n / 2; i++) {
+            removeHeapAt_int_Payload(&heap, 1 + randomBelow(heap.n), &key, NULL);
+            benchSink += key;
+        }
+        benchStop(&b, n / 2);
+
+        freeHeap_int_Payload(&heap);
+    }
+
+    /* Raises random elements above the top, so each one goes up the
+       whole path to the root. */
+    BENCH(b, "KeyValueHeap", "fixUpHeap", n) {
+        if (!buildHeap(&heap, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            k = 1 + randomBelow(heap.n);
+            heap.keys[k] = heap.keys[1] + 1;
+            fixUpHeap_int_Payload(&heap, k);
+        }
+        benchStop(&b, n);
+
+        freeHeap_int_Payload(&heap);
+    }
+
+    /* Lowers random elements below the bottom, so each one goes down
+       the whole path to a leaf. */
+    BENCH(b, "KeyValueHeap", "fixDownHeap", n) {
+        if (!buildHeap(&heap, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            k = 1 + randomBelow(heap.n);
+            heap.keys[k] = -1 - i;
+            fixDownHeap_int_Payload(&heap, k);
+        }
+        benchStop(&b, n);
+
+        freeHeap_int_Payload(&heap);
+    }
+}
+
+/*****************************************************************
+ *  Binary search tree.                                          *
+ ****************************************************************/
+/* Builds a tree with the given keys. Returns 1 on success. */
+static int buildTree(TreeNode_int_Payload **root, int *keys, long n) {
+    long i;
+
+    *root = NULL;
+    for (i = 0; i < n; i++) {
+        if (!putTree_int_Payload(root, keys[i], payloadOf(keys[i]))) {
+            freeTree_int_Payload(*root);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* Benchmarks all operations of trees of n nodes. */
+void benchKeyValueTree(long n) {
+    Bench b;
+    TreeNode_int_Payload *root, *p;
+    int *keys;
+    long i;
+
+    BENCH(b, "KeyValueBST", "putTree", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        root = NULL;
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            putTree_int_Payload(&root, keys[i], payloadOf(keys[i]));
+        }
+        benchStop(&b, n);
+
+        freeTree_int_Payload(root);
+        free(keys);
+    }
+
+    /* Finds every key, and reads its value, in an order unrelated
+       to insertion. */
+    BENCH(b, "KeyValueBST", "findTreeNode", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        if (!buildTree(&root, keys, n)) {
+            free(keys);
+            continue;
+        }
+        free(keys);
+        keys = randomPermutation(n);
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            p = findTreeNode_int_Payload(root, keys[i]);
+            benchSink += p->value.id;
+        }
+        benchStop(&b, n);
+
+        freeTree_int_Payload(root);
+        free(keys);
+    }
+
+    /* Removes half of the keys, in an order unrelated to insertion. */
+    BENCH(b, "KeyValueBST", "removeTreeNode", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        if (!buildTree(&root, keys, n)) {
+            free(keys);
+            continue;
+        }
+        free(keys);
+        keys = randomPermutation(n);
+
+        benchStart(&b);
+        for (i = 0; i < n / 2; i++) {
+            root = removeTreeNode_int_Payload(root, keys[i]);
+        }
+        benchStop(&b, n / 2);
+
+        freeTree_int_Payload(root);
+        free(keys);
+    }
+
+    BENCH(b, "KeyValueBST", "freeTree", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        if (!buildTree(&root, keys, n)) {
+            free(keys);
+            continue;
+        }
+
+        benchStart(&b);
+        freeTree_int_Payload(root);
+        benchStop(&b, n);
+
+        free(keys);
+    }
+}
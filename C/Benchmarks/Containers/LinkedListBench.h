@@ -0,0 +1,585 @@
+/*****************************************************************
+ *  Benchmarks shared by the singly and doubly linked lists,     *
+ *  which have the same operations. It is included by            *
+ *  SinglyLinkedListBench.c and DoublyLinkedListBench.c after    *
+ *  the list header, with these macros defined:                  *
+ *                                                               *
+ *  CONTAINER: name of the list in the results.                  *
+ *  BENCH_LIST: name of the function benchmarking it.            *
+ *  SINGLY_LINKED: defined for the operations only the singly    *
+ *  linked list has, and to time its removals at the tail, which *
+ *  walk the whole list, on fewer operations.                    *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "Harness.h"
+#include "Containers.h"
+
+#ifdef SINGLY_LINKED
+#define TAIL_OPS(n) linearOps(n)
+#else
+#define TAIL_OPS(n) (n)
+#endif
+
+/* Builds a list with 0, ..., n - 1, or NULL if there is no memory. */
+static Node *buildList(long n) {
+    Node *head = NULL, *newNode;
+    long i;
+
+    for (i = n - 1; i >= 0; i--) {
+        if (!(newNode = createNode(i))) {
+            freeList(head);
+            return NULL;
+        }
+        head = insertBeginning(head, newNode);
+    }
+
+    return head;
+}
+
+/* Builds a list header with 0, ..., n - 1. Returns 1 on success. */
+static int buildListHeader(List *list, long n) {
+    Node *newNode;
+    long i;
+
+    createList(list);
+    for (i = 0; i < n; i++) {
+        if (!(newNode = createNode(i))) {
+            clearList(list);
+            return 0;
+        }
+        insertEndList(list, newNode);
+    }
+
+    return 1;
+}
+
+/* Builds a list with n random values, or NULL if there is no memory. */
+static Node *buildRandomList(long n) {
+    Node *head = NULL, *newNode;
+    long i;
+
+    for (i = 0; i < n; i++) {
+        if (!(newNode = createNode(randomBelow(n)))) {
+            freeList(head);
+            return NULL;
+        }
+        head = insertBeginning(head, newNode);
+    }
+
+    return head;
+}
+
+/* Benchmarks all operations of lists of n nodes. Insertions include
+   the creation of the node, and popped nodes are freed after the
+   timed region. */
+void BENCH_LIST(long n) {
+    Bench b;
+    Node *head, *node, *popped, *a, *c;
+    List list, other, *parts;
+    int *keys;
+    long i, ops = linearOps(n), tailOps = TAIL_OPS(n);
+
+    /************************** Plain nodes ****************************/
+    BENCH(b, CONTAINER, "insertBeginning", n) {
+        head = NULL;
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            head = insertBeginning(head, createNode(i));
+        }
+        benchStop(&b, n);
+
+        freeList(head);
+    }
+
+    BENCH(b, CONTAINER, "insertEnd", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            head = insertEnd(head, createNode(i));
+        }
+        benchStop(&b, ops);
+
+        freeList(head);
+    }
+
+#ifdef SINGLY_LINKED
+    /* Inserts in the middle, so each insertion walks half the list. */
+    BENCH(b, CONTAINER, "insertAt", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            head = insertAt(head, createNode(i), (n + i) / 2);
+        }
+        benchStop(&b, ops);
+
+        freeList(head);
+    }
+
+    /* Searches for random values, all of them in the list. */
+    BENCH(b, CONTAINER, "searchNode", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            benchSink += searchNode(head, randomBelow(n));
+        }
+        benchStop(&b, ops);
+
+        freeList(head);
+    }
+#endif
+
+    BENCH(b, CONTAINER, "freeList", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        freeList(head);
+        benchStop(&b, n);
+    }
+
+    BENCH(b, CONTAINER, "removeNode", n) {
+        if (!(head = buildList(n)) || !(keys = randomPermutation(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            head = removeNode(head, keys[i]);
+        }
+        benchStop(&b, ops);
+
+        free(keys);
+        freeList(head);
+    }
+
+    BENCH(b, CONTAINER, "removeLastNode", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            head = removeLastNode(head);
+        }
+        benchStop(&b, ops);
+
+        freeList(head);
+    }
+
+    BENCH(b, CONTAINER, "lastNode", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            benchSink += lastNode(head)->info;
+        }
+        benchStop(&b, ops);
+
+        freeList(head);
+    }
+
+    BENCH(b, CONTAINER, "popLastNode", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+        popped = NULL;
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            node = popLastNode(&head);
+            node->next = popped;
+            popped = node;
+        }
+        benchStop(&b, ops);
+
+        freeList(popped);
+        freeList(head);
+    }
+
+    BENCH(b, CONTAINER, "popFirstNode", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+        popped = NULL;
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            node = popFirstNode(&head);
+            node->next = popped;
+            popped = node;
+        }
+        benchStop(&b, n);
+
+        freeList(popped);
+    }
+
+#ifdef SINGLY_LINKED
+    BENCH(b, CONTAINER, "removeFirstNode", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            head = removeFirstNode(head);
+        }
+        benchStop(&b, n);
+    }
+
+    BENCH(b, CONTAINER, "reverseList", n) {
+        if (!(head = buildList(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        head = reverseList(head);
+        benchStop(&b, n);
+
+        freeList(head);
+    }
+#endif
+
+    /************************** Recursive versions *********************/
+    if (n <= RECURSION_LIMIT) {
+        BENCH(b, CONTAINER, "insertEndRecursive", n) {
+            if (!(head = buildList(n))) {
+                continue;
+            }
+
+            benchStart(&b);
+            for (i = 0; i < ops; i++) {
+                head = insertEndRecursive(head, createNode(i));
+            }
+            benchStop(&b, ops);
+
+            freeList(head);
+        }
+
+        BENCH(b, CONTAINER, "freeListRecursive", n) {
+            if (!(head = buildList(n))) {
+                continue;
+            }
+
+            benchStart(&b);
+            freeListRecursive(head);
+            benchStop(&b, n);
+        }
+
+        BENCH(b, CONTAINER, "removeNodeRecursive", n) {
+            if (!(head = buildList(n)) || !(keys = randomPermutation(n))) {
+                continue;
+            }
+
+            benchStart(&b);
+            for (i = 0; i < ops; i++) {
+                head = removeNodeRecursive(head, keys[i]);
+            }
+            benchStop(&b, ops);
+
+            free(keys);
+            freeList(head);
+        }
+
+        BENCH(b, CONTAINER, "removeLastNodeRecursive", n) {
+            if (!(head = buildList(n))) {
+                continue;
+            }
+
+            benchStart(&b);
+            for (i = 0; i < ops; i++) {
+                head = removeLastNodeRecursive(head);
+            }
+            benchStop(&b, ops);
+
+            freeList(head);
+        }
+
+        BENCH(b, CONTAINER, "lastNodeRecursive", n) {
+            if (!(head = buildList(n))) {
+                continue;
+            }
+
+            benchStart(&b);
+            for (i = 0; i < ops; i++) {
+                benchSink += lastNodeRecursive(head)->info;
+            }
+            benchStop(&b, ops);
+
+            freeList(head);
+        }
+
+#ifdef SINGLY_LINKED
+        BENCH(b, CONTAINER, "reverseListRecursive", n) {
+            if (!(head = buildList(n))) {
+                continue;
+            }
+
+            benchStart(&b);
+            head = reverseListRecursive(head);
+            benchStop(&b, n);
+
+            freeList(head);
+        }
+#endif
+    }
+
+    /************************** List headers ***************************/
+    BENCH(b, CONTAINER, "insertEndList", n) {
+        createList(&list);
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            insertEndList(&list, createNode(i));
+        }
+        benchStop(&b, n);
+
+        clearList(&list);
+    }
+
+    BENCH(b, CONTAINER, "insertBeginningList", n) {
+        createList(&list);
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            insertBeginningList(&list, createNode(i));
+        }
+        benchStop(&b, n);
+
+        clearList(&list);
+    }
+
+    BENCH(b, CONTAINER, "clearList", n) {
+        if (!buildListHeader(&list, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        clearList(&list);
+        benchStop(&b, n);
+    }
+
+    BENCH(b, CONTAINER, "removeNodeList", n) {
+        if (!buildListHeader(&list, n) || !(keys = randomPermutation(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            removeNodeList(&list, keys[i]);
+        }
+        benchStop(&b, ops);
+
+        free(keys);
+        clearList(&list);
+    }
+
+    BENCH(b, CONTAINER, "removeFirstNodeList", n) {
+        if (!buildListHeader(&list, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            removeFirstNodeList(&list);
+        }
+        benchStop(&b, n);
+    }
+
+    BENCH(b, CONTAINER, "removeLastNodeList", n) {
+        if (!buildListHeader(&list, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < tailOps; i++) {
+            removeLastNodeList(&list);
+        }
+        benchStop(&b, tailOps);
+
+        clearList(&list);
+    }
+
+    BENCH(b, CONTAINER, "lastNodeList", n) {
+        if (!buildListHeader(&list, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            benchSink += lastNodeList(&list)->info;
+        }
+        benchStop(&b, n);
+
+        clearList(&list);
+    }
+
+    BENCH(b, CONTAINER, "popLastNodeList", n) {
+        if (!buildListHeader(&list, n)) {
+            continue;
+        }
+        popped = NULL;
+
+        benchStart(&b);
+        for (i = 0; i < tailOps; i++) {
+            node = popLastNodeList(&list);
+            node->next = popped;
+            popped = node;
+        }
+        benchStop(&b, tailOps);
+
+        freeList(popped);
+        clearList(&list);
+    }
+
+    BENCH(b, CONTAINER, "popFirstNodeList", n) {
+        if (!buildListHeader(&list, n)) {
+            continue;
+        }
+        popped = NULL;
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            node = popFirstNodeList(&list);
+            node->next = popped;
+            popped = node;
+        }
+        benchStop(&b, n);
+
+        freeList(popped);
+    }
+
+    BENCH(b, CONTAINER, "sizeList", n) {
+        if (!buildListHeader(&list, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            benchSink += sizeList(&list);
+        }
+        benchStop(&b, n);
+
+        clearList(&list);
+    }
+
+    /* Splices n lists of one node each into a single one. */
+    BENCH(b, CONTAINER, "spliceLists", n) {
+        if (!(parts = (List *) malloc(sizeof(List) * n))) {
+            continue;
+        }
+        for (i = 0; i < n; i++) {
+            createList(&parts[i]);
+            insertEndList(&parts[i], createNode(i));
+        }
+        createList(&list);
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            spliceLists(&list, &parts[i]);
+        }
+        benchStop(&b, n);
+
+        clearList(&list);
+        free(parts);
+    }
+
+    /************************** Sorting ********************************/
+    BENCH(b, CONTAINER, "mergeSort", n) {
+        if (!(head = buildRandomList(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        head = mergeSort(head);
+        benchStop(&b, n);
+
+        freeList(head);
+    }
+
+    BENCH(b, CONTAINER, "mergeSortList", n) {
+        createList(&list);
+        for (i = 0; i < n; i++) {
+            insertEndList(&list, createNode(randomBelow(n)));
+        }
+
+        benchStart(&b);
+        mergeSortList(&list);
+        benchStop(&b, n);
+
+        clearList(&list);
+    }
+
+    /* Merges the even and the odd values, so it alternates lists. */
+    BENCH(b, CONTAINER, "mergeSortedLists", n) {
+        a = c = NULL;
+        for (i = n - 1; i >= 0; i--) {
+            if (i % 2) {
+                c = insertBeginning(c, createNode(i));
+            }
+            else {
+                a = insertBeginning(a, createNode(i));
+            }
+        }
+
+        benchStart(&b);
+        head = mergeSortedLists(a, c);
+        benchStop(&b, n);
+
+        freeList(head);
+    }
+
+    /* Every value appears twice. */
+    BENCH(b, CONTAINER, "dedupeSorted", n) {
+        head = NULL;
+        for (i = n - 1; i >= 0; i--) {
+            head = insertBeginning(head, createNode(i / 2));
+        }
+
+        benchStart(&b);
+        head = dedupeSorted(head);
+        benchStop(&b, n);
+
+        freeList(head);
+    }
+
+    BENCH(b, CONTAINER, "mergeSortedListsList", n) {
+        createList(&list);
+        createList(&other);
+        for (i = 0; i < n; i++) {
+            insertEndList(i % 2 ? &other : &list, createNode(i));
+        }
+
+        benchStart(&b);
+        mergeSortedListsList(&list, &other);
+        benchStop(&b, n);
+
+        clearList(&list);
+    }
+
+    BENCH(b, CONTAINER, "dedupeSortedList", n) {
+        createList(&list);
+        for (i = 0; i < n; i++) {
+            insertEndList(&list, createNode(i / 2));
+        }
+
+        benchStart(&b);
+        dedupeSortedList(&list);
+        benchStop(&b, n);
+
+        clearList(&list);
+    }
+}
@@ -0,0 +1,74 @@
+/*****************************************************************
+ *  Benchmarks of the queue.                                     *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "../../DataStructures/Queues/WithSinglyLinkedLists/Queue.h"
+#include "Harness.h"
+#include "Containers.h"
+
+#define CONTAINER "Queue"
+
+/* Fills a queue with 0, ..., n - 1. Returns 1 on success. */
+static int buildQueue(Queue *q, long n) {
+    long i;
+
+    createQueue(q);
+    for (i = 0; i < n; i++) {
+        if (!enqueue(q, i)) {
+            freeQueue(q);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* Benchmarks all operations of queues of n elements. */
+void benchQueue(long n) {
+    Bench b;
+    Queue q;
+    Node *node, *dequeued;
+    long i;
+
+    BENCH(b, CONTAINER, "enqueue", n) {
+        createQueue(&q);
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            enqueue(&q, i);
+        }
+        benchStop(&b, n);
+
+        freeQueue(&q);
+    }
+
+    /* Empties the queue. */
+    BENCH(b, CONTAINER, "dequeue", n) {
+        if (!buildQueue(&q, n)) {
+            continue;
+        }
+        dequeued = NULL;
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            node = dequeue(&q);
+            node->next = dequeued;
+            dequeued = node;
+        }
+        benchStop(&b, n);
+
+        freeList(dequeued);
+        freeQueue(&q);
+    }
+
+    BENCH(b, CONTAINER, "freeQueue", n) {
+        if (!buildQueue(&q, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        freeQueue(&q);
+        benchStop(&b, n);
+    }
+}
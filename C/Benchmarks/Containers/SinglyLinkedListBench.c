@@ -0,0 +1,10 @@
+/*****************************************************************
+ *  Benchmarks of the singly linked list.                        *
+ ****************************************************************/
+#include "../../DataStructures/LinkedLists/SinglyLinkedLists/SinglyLinkedList.h"
+
+#define CONTAINER "SinglyLinkedList"
+#define BENCH_LIST benchSinglyLinkedList
+#define SINGLY_LINKED
+
+#include "LinkedListBench.h"
@@ -0,0 +1,130 @@
+/*****************************************************************
+ *  Benchmarks of the skip list. Keys are inserted in random     *
+ *  order, and searched keys are random numbers below 2n, so     *
+ *  half of them are found.                                      *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "../../DataStructures/SkipLists/SkipList.h"
+#include "Harness.h"
+#include "Containers.h"
+
+#define CONTAINER "SkipList"
+
+/* Keys walked by each range of skipListForRange. */
+#define RANGE_LENGTH 100
+
+/* Fills a list with the even keys 0 to 2n - 2, in random order.
+   Returns 1 on success. */
+static int buildList(SkipList *list, long n) {
+    int *keys;
+    long i;
+
+    if (!(keys = randomPermutation(n))) {
+        return 0;
+    }
+    if (!createSkipList(list, 42)) {
+        free(keys);
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        insertSkipList(list, 2 * keys[i]);
+    }
+
+    free(keys);
+    return 1;
+}
+
+/* Benchmarks all operations of lists of n keys. */
+void benchSkipList(long n) {
+    Bench b;
+    SkipList list;
+    SkipNode *p;
+    int *keys;
+    long i;
+
+    BENCH(b, CONTAINER, "insertSkipList", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        if (!createSkipList(&list, 42)) {
+            free(keys);
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            insertSkipList(&list, keys[i]);
+        }
+        benchStop(&b, n);
+
+        freeSkipList(&list);
+        free(keys);
+    }
+
+    BENCH(b, CONTAINER, "findSkipList", n) {
+        if (!(keys = (int *) malloc(sizeof(int) * n))) {
+            continue;
+        }
+        if (!buildList(&list, n)) {
+            free(keys);
+            continue;
+        }
+        for (i = 0; i < n; i++) {
+            keys[i] = randomBelow(2 * n);
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            benchSink += findSkipList(&list, keys[i]);
+        }
+        benchStop(&b, n);
+
+        freeSkipList(&list);
+        free(keys);
+    }
+
+    /* Walks n / RANGE_LENGTH random ranges, so about n / 2 keys in
+       total, and counts each key walked as an operation. */
+    BENCH(b, CONTAINER, "skipListForRange", n) {
+        long ranges = n / RANGE_LENGTH + 1, walked = 0;
+        int low;
+
+        if (!buildList(&list, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ranges; i++) {
+            low = randomBelow(2 * n);
+            skipListForRange(p, &list, low, low + RANGE_LENGTH) {
+                benchSink += p->info;
+                walked++;
+            }
+        }
+        benchStop(&b, walked ? walked : 1);
+
+        freeSkipList(&list);
+    }
+
+    /* Removes half of the keys, in an order unrelated to insertion. */
+    BENCH(b, CONTAINER, "removeSkipList", n) {
+        if (!(keys = randomPermutation(n))) {
+            continue;
+        }
+        if (!buildList(&list, n)) {
+            free(keys);
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n / 2; i++) {
+            removeSkipList(&list, 2 * keys[i]);
+        }
+        benchStop(&b, n / 2);
+
+        freeSkipList(&list);
+        free(keys);
+    }
+}
@@ -0,0 +1,91 @@
+/*****************************************************************
+ *  Benchmarks of snapshots of arrays and binary search trees,   *
+ *  saved to a temporary file. Mapping takes the same time at    *
+ *  every size, while loading copies or rebuilds the container,  *
+ *  which compares to BinarySearchTree/insertNode.               *
+ ****************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../../DataStructures/DynamicArrays/DynamicArray.h"
+#include "Harness.h"
+#include "Containers.h"
+
+/* Trees are benchmarked along BinarySearchTree, since its header
+   defines Node too. */
+#define CONTAINER "Snapshot"
+
+/* Times of mapping and unmapping a snapshot, per pair. */
+#define MAP_OPS 1000
+
+/* Writes the name of the temporary snapshot file in path. */
+void snapshotPath(char *path, size_t size) {
+    const char *directory = getenv("TMPDIR");
+
+    snprintf(path, size, "%s/containers-%d.snapshot", directory ? directory : "/tmp", (int) getpid());
+}
+
+/* Benchmarks snapshots of arrays of n elements. */
+void benchArraySnapshot(long n) {
+    Bench b;
+    Array array, mapped;
+    Snapshot snapshot;
+    char path[256];
+    long i;
+
+    snapshotPath(path, sizeof(path));
+
+    if (!createArray(&array, n)) {
+        return;
+    }
+    for (i = 0; i < n; i++) {
+        insertArray(&array, randomBelow(n));
+    }
+
+    BENCH(b, CONTAINER, "saveArray", n) {
+        benchStart(&b);
+        if (!saveArray(&array, path)) {
+            continue;
+        }
+        benchStop(&b, n);
+    }
+
+    /* Mapping does not depend on the size, so it is timed per map. */
+    BENCH(b, CONTAINER, "mapArray", n) {
+        benchStart(&b);
+        for (i = 0; i < MAP_OPS && mapArray(&mapped, &snapshot, path, SNAPSHOT_READ_ONLY); i++) {
+            benchSink += mapped.n;
+            unmapSnapshot(&snapshot);
+        }
+        if (i < MAP_OPS) {
+            continue;
+        }
+        benchStop(&b, MAP_OPS);
+    }
+
+    /* Verifying reads every element, so it is timed per element. */
+    BENCH(b, CONTAINER, "mapArray+verify", n) {
+        benchStart(&b);
+        if (!mapArray(&mapped, &snapshot, path, SNAPSHOT_READ_ONLY | SNAPSHOT_VERIFY)) {
+            continue;
+        }
+        benchSink += mapped.n;
+        unmapSnapshot(&snapshot);
+        benchStop(&b, n);
+    }
+
+    BENCH(b, CONTAINER, "loadArray", n) {
+        benchStart(&b);
+        if (!loadArray(&mapped, path)) {
+            continue;
+        }
+        benchStop(&b, n);
+
+        benchSink += mapped.n;
+        freeArray(&mapped);
+    }
+
+    freeArray(&array);
+    unlink(path);
+}
@@ -0,0 +1,72 @@
+/*****************************************************************
+ *  Benchmarks of the stack.                                     *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "../../DataStructures/Stacks/WithSinglyLinkedLists/Stack.h"
+#include "Harness.h"
+#include "Containers.h"
+
+#define CONTAINER "Stack"
+
+/* Fills a stack with 0, ..., n - 1. Returns 1 on success. */
+static int buildStack(Stack *s, long n) {
+    long i;
+
+    createStack(s);
+    for (i = 0; i < n; i++) {
+        if (!pushStack(s, i)) {
+            freeStack(s);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* Benchmarks all operations of stacks of n elements. */
+void benchStack(long n) {
+    Bench b;
+    Stack s;
+    Node *node, *popped;
+    long i;
+
+    BENCH(b, CONTAINER, "pushStack", n) {
+        createStack(&s);
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            pushStack(&s, i);
+        }
+        benchStop(&b, n);
+
+        freeStack(&s);
+    }
+
+    BENCH(b, CONTAINER, "popStack", n) {
+        if (!buildStack(&s, n)) {
+            continue;
+        }
+        popped = NULL;
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            node = popStack(&s);
+            node->next = popped;
+            popped = node;
+        }
+        benchStop(&b, n);
+
+        freeList(popped);
+    }
+
+    BENCH(b, CONTAINER, "freeStack", n) {
+        if (!buildStack(&s, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        freeStack(&s);
+        benchStop(&b, n);
+    }
+}
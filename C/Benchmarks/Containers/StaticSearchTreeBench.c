@@ -0,0 +1,108 @@
+/*****************************************************************
+ *  Benchmarks of the static search tree, against binary search  *
+ *  on the sorted array it is built from. Keys are the even      *
+ *  numbers below 2n, and searched values are random numbers     *
+ *  below 2n, so half of them are found. It only needs 8 bytes   *
+ *  per key, so it runs up to 1e9 keys.                          *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "../../DataStructures/Trees/StaticSearchTrees/StaticSearchTree.h"
+#include "Harness.h"
+#include "Containers.h"
+
+#define CONTAINER "StaticSearchTree"
+
+/* Searches timed at each size. */
+#define MAX_QUERIES 1000000
+
+/* Returns the position of the least element of sorted not lesser
+   than key, or n if there is none, with a plain binary search. */
+static long binarySearch(const int *sorted, long n, int key) {
+    long low = 0, high = n, middle;
+
+    while (low < high) {
+        middle = low + (high - low) / 2;
+
+        if (sorted[middle] < key) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/* Benchmarks all operations of static trees of n keys. */
+void benchStaticSearchTree(long n) {
+    Bench b;
+    StaticTree tree;
+    int *sorted, *queries;
+    long *results, i, m = n < MAX_QUERIES ? n : MAX_QUERIES;
+
+    sorted = (int *) malloc(sizeof(int) * n);
+    queries = (int *) malloc(sizeof(int) * m);
+    results = (long *) malloc(sizeof(long) * m);
+    if (!sorted || !queries || !results) {
+        free(sorted);
+        free(queries);
+        free(results);
+        return;
+    }
+
+    for (i = 0; i < n; i++) {
+        sorted[i] = 2 * i;
+    }
+    for (i = 0; i < m; i++) {
+        queries[i] = randomBelow(2 * n);
+    }
+
+    BENCH(b, CONTAINER, "createStaticTree", n) {
+        benchStart(&b);
+        if (!createStaticTree(&tree, sorted, n)) {
+            continue;
+        }
+        benchStop(&b, n);
+
+        freeStaticTree(&tree);
+    }
+
+    /* Baseline: the same searches on the sorted array. */
+    BENCH(b, CONTAINER, "binarySearch", n) {
+        benchStart(&b);
+        for (i = 0; i < m; i++) {
+            benchSink += binarySearch(sorted, n, queries[i]);
+        }
+        benchStop(&b, m);
+    }
+
+    if (!createStaticTree(&tree, sorted, n)) {
+        free(sorted);
+        free(queries);
+        free(results);
+        return;
+    }
+
+    BENCH(b, CONTAINER, "lowerBound", n) {
+        benchStart(&b);
+        for (i = 0; i < m; i++) {
+            benchSink += lowerBound(&tree, queries[i]);
+        }
+        benchStop(&b, m);
+    }
+
+    BENCH(b, CONTAINER, "lowerBoundMany", n) {
+        benchStart(&b);
+        lowerBoundMany(&tree, queries, m, results);
+        benchStop(&b, m);
+
+        benchSink += results[m - 1];
+    }
+
+    freeStaticTree(&tree);
+    free(sorted);
+    free(queries);
+    free(results);
+}
@@ -0,0 +1,199 @@
+/*****************************************************************
+ *  Benchmarks of the array and list templates: an array of      *
+ *  24-byte records compared by their id only, and a list of     *
+ *  long longs compared with ==. Values are the same as in       *
+ *  DynamicArray and SinglyLinkedList, so their times compare    *
+ *  to the ones of the int structures.                           *
+ ****************************************************************/
+#include <stdlib.h>
+
+#include "../../DataStructures/DynamicArrays/DynamicArrayTemplate.h"
+#include "../../DataStructures/LinkedLists/SinglyLinkedLists/SinglyLinkedListTemplate.h"
+#include "Harness.h"
+#include "Containers.h"
+
+/* Element of the array, equal to another one with the same id. */
+typedef struct {
+    long id;
+    double price, amount;
+} Order;
+
+#define sameOrder(a, b) ((a).id == (b).id)
+
+typedef long long llong;
+
+DEFINE_ARRAY(Order)
+DEFINE_ARRAY_SEARCH(Order, sameOrder)
+DEFINE_LIST(llong)
+DEFINE_LIST_SEARCH(llong, ADS_EQUAL)
+
+/* Returns the order with an id. */
+static Order orderOf(long id) {
+    Order order = {id, id * 0.5, 1};
+
+    return order;
+}
+
+/*****************************************************************
+ *  Array.                                                       *
+ ****************************************************************/
+/* Fills an array with the orders 0, ..., n - 1. Returns 1 on
+   success. */
+static int buildArray(Array_Order *array, long n) {
+    long i;
+
+    if (!createArray_Order(array, n)) {
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        array->info[i] = orderOf(i);
+    }
+    array->n = n;
+
+    return 1;
+}
+
+/* Benchmarks all operations of arrays of n records. */
+void benchArrayTemplate(long n) {
+    Bench b;
+    Array_Order array;
+    int *keys;
+    long i, ops;
+
+    ops = linearOps(n);
+
+    /* Appends from a small array, so it includes all reallocations. */
+    BENCH(b, "OrderArray", "insertArray", n) {
+        if (!createArray_Order(&array, 1)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            insertArray_Order(&array, orderOf(i));
+        }
+        benchStop(&b, n);
+
+        freeArray_Order(&array);
+    }
+
+    /* Searches for random ids, all of them in the array. */
+    BENCH(b, "OrderArray", "findArray", n) {
+        if (!buildArray(&array, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            benchSink += findArray_Order(&array, orderOf(randomBelow(n)));
+        }
+        benchStop(&b, ops);
+
+        freeArray_Order(&array);
+    }
+
+    /* Removals by value search for distinct random ids. */
+    BENCH(b, "OrderArray", "removeArray", n) {
+        if (!buildArray(&array, n) || !(keys = randomPermutation(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            removeArray_Order(&array, orderOf(keys[i]));
+        }
+        benchStop(&b, ops);
+
+        free(keys);
+        freeArray_Order(&array);
+    }
+}
+
+/*****************************************************************
+ *  List.                                                        *
+ ****************************************************************/
+/* Builds a list header with 0, ..., n - 1. Returns 1 on success. */
+static int buildList(List_llong *list, long n) {
+    Node_llong *newNode;
+    long i;
+
+    createList_llong(list);
+    for (i = 0; i < n; i++) {
+        if (!(newNode = createNode_llong(i))) {
+            clearList_llong(list);
+            return 0;
+        }
+        insertEndList_llong(list, newNode);
+    }
+
+    return 1;
+}
+
+/* Benchmarks all operations of lists of n nodes. Insertions include
+   the creation of the node. */
+void benchListTemplate(long n) {
+    Bench b;
+    List_llong list;
+    Node_llong *p;
+    int *keys;
+    long i, ops;
+
+    ops = linearOps(n);
+
+    BENCH(b, "LongList", "insertEndList", n) {
+        createList_llong(&list);
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            insertEndList_llong(&list, createNode_llong(i));
+        }
+        benchStop(&b, n);
+
+        clearList_llong(&list);
+    }
+
+    BENCH(b, "LongList", "popFirstNodeList", n) {
+        if (!buildList(&list, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < n; i++) {
+            p = popFirstNodeList_llong(&list);
+            benchSink += p->info;
+            free(p);
+        }
+        benchStop(&b, n);
+    }
+
+    /* Searches for random values, all of them in the list. */
+    BENCH(b, "LongList", "findNodeList", n) {
+        if (!buildList(&list, n)) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            benchSink += findNodeList_llong(&list, randomBelow(n))->info;
+        }
+        benchStop(&b, ops);
+
+        clearList_llong(&list);
+    }
+
+    BENCH(b, "LongList", "removeNodeList", n) {
+        if (!buildList(&list, n) || !(keys = randomPermutation(n))) {
+            continue;
+        }
+
+        benchStart(&b);
+        for (i = 0; i < ops; i++) {
+            removeNodeList_llong(&list, keys[i]);
+        }
+        benchStop(&b, ops);
+
+        free(keys);
+        clearList_llong(&list);
+    }
+}
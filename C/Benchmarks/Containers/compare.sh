@@ -0,0 +1,46 @@
+#!/bin/sh
+# Compares two CSV results of the containers benchmark, matching
+# benchmarks by container, operation and size, and flags the ones
+# whose median time per operation changed more than the threshold.
+# To tell noise apart, a slowdown is only flagged as a regression if
+# even the fastest new run is slower than the median old one, and
+# conversely for improvements. Exits with 1 if there is any regression.
+#
+# Usage: ./compare.sh old.csv new.csv [threshold_percent]   (default 10)
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 old.csv new.csv [threshold_percent]" >&2
+    exit 2
+fi
+
+awk -F, -v threshold="${3:-10}" '
+    FNR == 1 { next }
+    NR == FNR { oldMin[$1 "," $2 "," $3] = $6; oldMedian[$1 "," $2 "," $3] = $7; next }
+    {
+        key = $1 "," $2 "," $3
+        if (!(key in oldMedian)) {
+            next
+        }
+
+        change = 100 * ($7 - oldMedian[key]) / oldMedian[key]
+        status = ""
+        if (change > threshold && $6 > oldMedian[key]) {
+            status = "REGRESSION"
+            regressions++
+        }
+        else if (change < -threshold && $7 < oldMin[key]) {
+            status = "improvement"
+            improvements++
+        }
+
+        printf "%-18s %-24s %10s %12.2f %12.2f %+8.1f%%  %s\n", $1, $2, $3, oldMedian[key], $7, change, status
+        compared++
+    }
+    BEGIN {
+        printf "%-18s %-24s %10s %12s %12s %9s\n", "container", "operation", "n", "old ns/op", "new ns/op", "change"
+    }
+    END {
+        printf "\n%d benchmarks compared: %d regressions, %d improvements (threshold %s%%).\n", compared, regressions, improvements, threshold
+        exit regressions > 0
+    }
+' "$1" "$2"
@@ -0,0 +1,222 @@
+/*****************************************************************
+ *  Measures how the concurrent skip list scales with threads,   *
+ *  for mixes of searches and changes, against the sequential    *
+ *  skip list behind one mutex. Keys are random numbers below    *
+ *  2n, in a list that starts with n random insertions. Half of  *
+ *  the changes insert and half remove, so its size stays about  *
+ *  the same.                                                    *
+ ****************************************************************/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../DataStructures/SkipLists/SkipList.h"
+#include "../DataStructures/SkipLists/ConcurrentSkipList.h"
+
+/* Settings of each run. */
+#define DEFAULT_KEYS 1000000
+#define DEFAULT_MAX_THREADS 8
+#define DEFAULT_MILLISECONDS 1000
+#define SEED 42
+
+/* Percentages of searches of each mix. */
+static const int mixes[] = {100, 90, 50};
+
+/* Lists under test. Only one of them is used in each run. */
+static ConcurrentSkipList concurrent;
+static SkipList locked;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Shared state of a run. */
+static atomic_int running;
+static int readPercentage, useLock;
+static long range;
+
+/* Operations done by each thread, each in its own cache line. */
+typedef struct {
+    _Alignas(64) long ops;
+    unsigned long seed;
+} Worker;
+
+/* Returns the current time, in seconds. */
+static double now() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Returns the next random number of a xorshift generator. */
+static unsigned long nextRandom(unsigned long *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/* Runs random operations on the list under test until stopped. */
+static void *work(void *arg) {
+    Worker *worker = (Worker *) arg;
+    unsigned long r;
+    long ops = 0;
+    int key, choice;
+
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        r = nextRandom(&worker->seed);
+        key = (r >> 8) % range;
+        choice = r % 200;
+
+        if (useLock) {
+            pthread_mutex_lock(&lock);
+            if (choice < 2 * readPercentage) {
+                findSkipList(&locked, key);
+            }
+            else if (choice % 2) {
+                insertSkipList(&locked, key);
+            }
+            else {
+                removeSkipList(&locked, key);
+            }
+            pthread_mutex_unlock(&lock);
+        }
+        else if (choice < 2 * readPercentage) {
+            findConcurrentSkipList(&concurrent, key);
+        }
+        else if (choice % 2) {
+            insertConcurrentSkipList(&concurrent, key);
+        }
+        else {
+            removeConcurrentSkipList(&concurrent, key);
+        }
+
+        ops++;
+    }
+
+    worker->ops = ops;
+    return NULL;
+}
+
+/* Inserts n random keys in the list under test, runs the given
+   number of threads for some milliseconds and returns millions of
+   operations per second. */
+static double run(long n, int threads, int milliseconds) {
+    pthread_t *ids = (pthread_t *) malloc(sizeof(pthread_t) * threads);
+    Worker *workers = (Worker *) aligned_alloc(64, sizeof(Worker) * threads);
+    struct timespec pause;
+    unsigned long seed = SEED;
+    double start, elapsed;
+    long i, ops = 0;
+
+    if (!ids || !workers) {
+        free(ids);
+        free(workers);
+        return 0;
+    }
+
+    if (useLock) {
+        createSkipList(&locked, SEED);
+    }
+    else {
+        createConcurrentSkipList(&concurrent, SEED);
+    }
+    for (i = 0; i < n; i++) {
+        if (useLock) {
+            insertSkipList(&locked, nextRandom(&seed) % range);
+        }
+        else {
+            insertConcurrentSkipList(&concurrent, nextRandom(&seed) % range);
+        }
+    }
+
+    atomic_store(&running, 1);
+    start = now();
+    for (i = 0; i < threads; i++) {
+        workers[i].ops = 0;
+        workers[i].seed = SEED + 7919 * (i + 1);
+        pthread_create(&ids[i], NULL, work, &workers[i]);
+    }
+
+    pause.tv_sec = milliseconds / 1000;
+    pause.tv_nsec = (milliseconds % 1000) * 1000000L;
+    nanosleep(&pause, NULL);
+    atomic_store(&running, 0);
+
+    for (i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+        ops += workers[i].ops;
+    }
+    elapsed = now() - start;
+
+    if (useLock) {
+        freeSkipList(&locked);
+    }
+    else {
+        freeConcurrentSkipList(&concurrent);
+    }
+    free(ids);
+    free(workers);
+
+    return ops / elapsed / 1e6;
+}
+
+/* Prints the command line options. */
+void usage(char *program) {
+    fprintf(stderr, "Usage: %s [-n keys] [-t max_threads] [-m milliseconds]\n"
+        "  -n  keys inserted before each run (default %d)\n"
+        "  -t  most threads, doubling from 1 (default %d)\n"
+        "  -m  duration of each run (default %d)\n",
+        program, DEFAULT_KEYS, DEFAULT_MAX_THREADS, DEFAULT_MILLISECONDS);
+}
+
+int main(int argc, char *argv[]) {
+    long n = DEFAULT_KEYS;
+    int maxThreads = DEFAULT_MAX_THREADS, milliseconds = DEFAULT_MILLISECONDS;
+    int opt, threads;
+    double lockFree, mutex;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "n:t:m:")) != -1) {
+        switch (opt) {
+            case 'n':
+                n = atol(optarg);
+                break;
+            case 't':
+                maxThreads = atoi(optarg);
+                break;
+            case 'm':
+                milliseconds = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (n < 1 || n > 1000000000 || maxThreads < 1 || milliseconds < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+    range = 2 * n;
+
+    printf("%ld insertions, %ld online processors\n", n, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-8s %8s %16s %16s %9s\n", "finds", "threads", "lock-free Mop/s", "mutex Mop/s", "speedup");
+
+    for (i = 0; i < sizeof(mixes) / sizeof(mixes[0]); i++) {
+        readPercentage = mixes[i];
+
+        for (threads = 1; threads <= maxThreads; threads *= 2) {
+            useLock = 0;
+            lockFree = run(n, threads, milliseconds);
+            useLock = 1;
+            mutex = run(n, threads, milliseconds);
+
+            printf("%7d%% %8d %16.2f %16.2f %8.2fx\n", readPercentage, threads, lockFree, mutex,
+                mutex > 0 ? lockFree / mutex : 0);
+        }
+    }
+
+    return 0;
+}
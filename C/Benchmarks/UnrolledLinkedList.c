@@ -0,0 +1,135 @@
+/*****************************************************************
+ *  Compares the unrolled linked list against the singly linked  *
+ *  list for iteration, insertion in the middle and search.      *
+ ****************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../DataStructures/LinkedLists/SinglyLinkedLists/SinglyLinkedList.h"
+#include "../DataStructures/LinkedLists/UnrolledLinkedLists/UnrolledLinkedList.h"
+
+/* Total amount of nodes visited per measured operation kind. */
+#define WORK 100000000L
+
+/* Keeps the compiler from discarding the measured loops. */
+volatile long sink;
+
+/* Returns a monotonic timestamp in nanoseconds. */
+double now() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Walks the singly linked list summing its elements. */
+long sumSingly(Node *head) {
+    long sum = 0;
+
+    for (; head; head = head->next) {
+        sum += head->info;
+    }
+
+    return sum;
+}
+
+/* Walks the unrolled linked list summing its elements. */
+long sumUnrolled(UnrolledNode *head) {
+    long sum = 0;
+    int i;
+
+    for (; head; head = head->next) {
+        for (i = 0; i < head->n; i++) {
+            sum += head->info[i];
+        }
+    }
+
+    return sum;
+}
+
+/* Benchmarks both lists with n elements. */
+void run(int n) {
+    Node *singly = NULL;
+    UnrolledNode *unrolled = NULL;
+    double t, iterS, iterU, insS, insU, srcS, srcU;
+    int i, reps;
+
+    /* Builds both lists with the same contents. Insertion in
+       the beginning keeps the singly list build linear. */
+    for (i = n - 1; i >= 0; i--) {
+        singly = insertBeginning(singly, createNode(i));
+    }
+    for (i = 0; i < n; i++) {
+        insertUnrolledEnd(&unrolled, i);
+    }
+
+    reps = WORK / n > 0 ? WORK / n : 1;
+
+    /* Iteration. */
+    t = now();
+    for (i = 0; i < reps; i++) {
+        sink += sumSingly(singly);
+    }
+    iterS = (now() - t) / ((double) reps * n);
+
+    t = now();
+    for (i = 0; i < reps; i++) {
+        sink += sumUnrolled(unrolled);
+    }
+    iterU = (now() - t) / ((double) reps * n);
+
+    /* Search, for values spread across the whole list. */
+    reps = 2 * WORK / n / 10 > 0 ? 2 * WORK / n / 10 : 1;
+
+    t = now();
+    for (i = 0; i < reps; i++) {
+        sink += searchNode(singly, random() % n);
+    }
+    srcS = (now() - t) / reps;
+
+    t = now();
+    for (i = 0; i < reps; i++) {
+        sink += searchUnrolled(unrolled, random() % n);
+    }
+    srcU = (now() - t) / reps;
+
+    /* Insertion in the middle. */
+    t = now();
+    for (i = 0; i < reps; i++) {
+        singly = insertAt(singly, createNode(-i), (n + i) / 2);
+    }
+    insS = (now() - t) / reps;
+
+    t = now();
+    for (i = 0; i < reps; i++) {
+        insertUnrolledAt(&unrolled, -i, (n + i) / 2);
+    }
+    insU = (now() - t) / reps;
+
+    printf("%10d  %-14s %12.2f %12.2f %8.2fx\n", n, "iterate/elem", iterS, iterU, iterS / iterU);
+    printf("%10d  %-14s %12.2f %12.2f %8.2fx\n", n, "search", srcS, srcU, srcS / srcU);
+    printf("%10d  %-14s %12.2f %12.2f %8.2fx\n", n, "insert middle", insS, insU, insS / insU);
+
+    freeList(singly);
+    freeUnrolledList(unrolled);
+}
+
+int main(int argc, char *argv[]) {
+    int n, maxN;
+
+    maxN = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    srandom(42);
+
+    printf("Unrolled node capacity: %d ints (%zu bytes per node)\n",
+        UNROLLED_NODE_CAPACITY, sizeof(UnrolledNode));
+    printf("%10s  %-14s %12s %12s %9s\n", "n", "operation", "singly ns", "unrolled ns", "speedup");
+
+    for (n = 1000; n <= maxN; n *= 10) {
+        run(n);
+    }
+
+    return 0;
+}
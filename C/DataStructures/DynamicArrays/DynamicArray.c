@@ -1,5 +1,7 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
 
 #include "DynamicArray.h"
 
@@ -65,8 +67,6 @@ void freeArray(Array *array) {
  * It returns 0 in case of error and 1 in case of success.
  */
 int insertArray(Array *array, int elem) {
-    int n, *allocResult;
-
     return insertArrayAt(array, elem, array->n);
 }
 
@@ -89,7 +89,7 @@ int insertArray(Array *array, int elem) {
  * It returns 0 in case of error and 1 in case of success.
  */
 int insertArrayAt(Array *array, int elem, int pos) {
-    int i, *allocResult;
+    int i, size, *allocResult;
 
     int n = array->n;
     if (!array || pos < 0 || pos > n) {
@@ -98,8 +98,10 @@ int insertArrayAt(Array *array, int elem, int pos) {
 
     // If the array can't fit more elements.
     if (n == array->size) {
-        // Reallocates the memory for the elements array.
-        allocResult = (int *) realloc(array->info, sizeof(int) * n * 1.25);
+        // Reallocates the memory for the elements array, with
+        // at least one more element, so small arrays grow too.
+        size = n + n / 4 + 1;
+        allocResult = (int *) realloc(array->info, sizeof(int) * size);
 
         // Returns 0 if it is not possible.
         if (!allocResult) {
@@ -107,7 +109,7 @@ int insertArrayAt(Array *array, int elem, int pos) {
         }
 
         array->info = allocResult;
-        array->size *= 1.25;
+        array->size = size;
     }
 
     // Moves to the right all elements from pos on.
@@ -139,7 +141,7 @@ int insertArrayAt(Array *array, int elem, int pos) {
  * It returns 0 in case of error and 1 in case of success.
  */
 int removeArray(Array *array, int elem) {
-    int i, n, aux, *allocResult;
+    int i, n;
 
     if (!array) {
         return 0;
@@ -176,7 +178,7 @@ int removeArray(Array *array, int elem) {
  * It returns 0 in case of error and 1 in case of success.
  */
 int removeArrayStable(Array *array, int elem) {
-    int i, j, n, aux, *allocResult;
+    int i, n;
 
     if (!array) {
         return 0;
@@ -191,7 +193,7 @@ int removeArrayStable(Array *array, int elem) {
 
     // If it was found.
     if (i < n) {
-        return removeArrayAtStable(array, array->n-1);
+        return removeArrayAtStable(array, i);
     }
 
     return 1;
@@ -214,7 +216,7 @@ int removeArrayStable(Array *array, int elem) {
  * It returns 0 in case of error and 1 in case of success.
  */
 int removeArrayAt(Array *array, int pos) {
-    int i, n, aux, *allocResult;
+    int n, aux, size, *allocResult;
 
     if (!array || pos < 0 || pos >= array->n) {
         return 0;
@@ -231,14 +233,15 @@ int removeArrayAt(Array *array, int pos) {
 
     // Reallocates memory for the array of elements, if necessary.
     if (n < array->size * 0.25) {
-        allocResult = (int *) realloc(array->info, sizeof(int) * array->size * 0.5 + 1);
+        size = array->size / 2 + 1;
+        allocResult = (int *) realloc(array->info, sizeof(int) * size);
 
         if (!allocResult) {
             return 0;
         }
 
         array->info = allocResult;
-        array->size *= 0.5;
+        array->size = size;
     }
 
     return 1;
@@ -260,7 +263,7 @@ int removeArrayAt(Array *array, int pos) {
  * It returns 0 in case of error and 1 in case of success.
  */
 int removeArrayAtStable(Array *array, int pos) {
-    int i, n, aux, *allocResult;
+    int i, n, size, *allocResult;
 
     n = array->n;
     if (!array || pos < 0 || pos >= n) {
@@ -277,14 +280,15 @@ int removeArrayAtStable(Array *array, int pos) {
 
     // Reallocates memory for the array of elements, if necessary.
     if (array->n < array->size * 0.25) {
-        allocResult = (int *) realloc(array->info, sizeof(int) * array->size * 0.5 + 1);
+        size = array->size / 2 + 1;
+        allocResult = (int *) realloc(array->info, sizeof(int) * size);
 
         if (!allocResult) {
             return 0;
         }
 
         array->info = allocResult;
-        array->size *= 0.5;
+        array->size = size;
     }
 
     return 1;
@@ -304,10 +308,89 @@ void swapElements(Array *array, int i, int j) {
     int aux;
 
     aux = array->info[i];
-    arra->info[i] = array->info[j];
+    array->info[i] = array->info[j];
     array->info[j] = aux;
 }
 
+/******************************************************
+ ***************** SNAPSHOTS **************************
+ ******************************************************/
+/**
+ * Saves the elements of the array in a snapshot file
+ * (see Snapshot.h).
+ *
+ * @param array: A pointer to the array.
+ * @param path: The name of the file.
+ * @return 1 if successful, 0 otherwise.
+ */
+int saveArray(const Array *array, const char *path) {
+    if (!array) {
+        return 0;
+    }
+
+    return writeSnapshot(path, SNAPSHOT_ARRAY, array->info, array->n);
+}
+
+/**
+ * Maps a snapshot file of an array, which is used in place.
+ *
+ * It takes O(1), no matter the size of the array. The array
+ * points into the snapshot, so it must not grow, shrink or be
+ * freed. Unmapping the snapshot ends it.
+ *
+ * @param array: A pointer to the array structure to be initialized.
+ * @param snapshot: A pointer to the snapshot to be mapped.
+ * @param path: The name of the file.
+ * @param mode: The mapping mode (see Snapshot.h).
+ * @return 1 if successful, 0 otherwise.
+ */
+int mapArray(Array *array, Snapshot *snapshot, const char *path, int mode) {
+    if (!array || !mapSnapshot(snapshot, path, SNAPSHOT_ARRAY, mode)) {
+        return 0;
+    }
+
+    if (snapshot->n > INT_MAX) {
+        unmapSnapshot(snapshot);
+        return 0;
+    }
+
+    array->info = snapshot->info;
+    array->n = array->size = snapshot->n;
+
+    return 1;
+}
+
+/**
+ * Loads a snapshot file of an array into a new array.
+ *
+ * It copies the elements, so the array is an ordinary one.
+ * The snapshot is verified against its checksum.
+ *
+ * @param array: A pointer to the array structure to be initialized.
+ * @param path: The name of the file.
+ * @return 1 if successful, 0 otherwise.
+ */
+int loadArray(Array *array, const char *path) {
+    Snapshot snapshot;
+    Array mapped;
+
+    if (!mapArray(&mapped, &snapshot, path, SNAPSHOT_READ_ONLY | SNAPSHOT_VERIFY)) {
+        return 0;
+    }
+
+    if (!createArray(array, mapped.n > 4 ? mapped.n : 4)) {
+        unmapSnapshot(&snapshot);
+        return 0;
+    }
+
+    memcpy(array->info, mapped.info, sizeof(int) * mapped.n);
+    array->n = mapped.n;
+
+    unmapSnapshot(&snapshot);
+
+    return 1;
+}
+
 /******************************************************
  ***************** OUTPUT *****************************
  ******************************************************/
@@ -319,7 +402,7 @@ void swapElements(Array *array, int i, int j) {
  *
  * @param array: The array to be printed.
  */
-void print(Array array) {
+void printArray(Array array) {
     int i, n;
 
     n = array.n;
@@ -1,3 +1,8 @@
+#ifndef DYNAMIC_ARRAY_H
+#define DYNAMIC_ARRAY_H
+
+#include "../Snapshots/Snapshot.h"
+
 typedef struct array {
     // Defines a array of ints. n will store the
     // number of elements in the array and size
@@ -6,6 +11,22 @@ typedef struct array {
     int *info, n, size;
 } Array;
 
+// Exported names, prefixed so the array links into the same
+// library as the other structures.
+#define createArray         ads_array_createArray
+#define freeArray           ads_array_freeArray
+#define insertArray         ads_array_insertArray
+#define insertArrayAt       ads_array_insertArrayAt
+#define removeArray         ads_array_removeArray
+#define removeArrayStable   ads_array_removeArrayStable
+#define removeArrayAt       ads_array_removeArrayAt
+#define removeArrayAtStable ads_array_removeArrayAtStable
+#define swapElements        ads_array_swapElements
+#define printArray          ads_array_printArray
+#define saveArray           ads_array_saveArray
+#define mapArray            ads_array_mapArray
+#define loadArray           ads_array_loadArray
+
 int createArray(Array *array, int n);
 void freeArray(Array *array);
 int insertArray(Array *array, int elem);
@@ -15,4 +36,9 @@ int removeArrayStable(Array *array, int elem);
 int removeArrayAt(Array *array, int pos);
 int removeArrayAtStable(Array *array, int pos);
 void swapElements(Array *array, int i, int j);
-void print(Array array);
+void printArray(Array array);
+int saveArray(const Array *array, const char *path);
+int mapArray(Array *array, Snapshot *snapshot, const char *path, int mode);
+int loadArray(Array *array, const char *path);
+
+#endif // DYNAMIC_ARRAY_H
@@ -0,0 +1,207 @@
+#ifndef DYNAMIC_ARRAY_TEMPLATE_H
+#define DYNAMIC_ARRAY_TEMPLATE_H
+
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Dynamic arrays of any type. DEFINE_ARRAY(T) generates the
+// type Array_T and its functions, named as the ones of the
+// int array (DynamicArray.h) followed by _T. They are static
+// inline, so each instantiation is compiled and inlined for
+// its own type where it is used, without void pointers or
+// function pointers. The int array in libads stays the default.
+//
+// T must be a single identifier, so types such as unsigned
+// long or structs need a typedef first. Functions searching
+// by value are generated apart, by DEFINE_ARRAY_SEARCH(T, equal),
+// since records need their own equality. equal(a, b) may be a
+// macro or a function, and ADS_EQUAL compares with ==.
+//
+// Example:
+//
+//     typedef struct {
+//         long id;
+//         double price, amount;
+//     } Order;
+//     #define sameOrder(a, b) ((a).id == (b).id)
+//
+//     DEFINE_ARRAY(Order)
+//     DEFINE_ARRAY_SEARCH(Order, sameOrder)
+//
+//     Array_Order orders;
+//     Order o = {42, 9.5, 3};
+//
+//     createArray_Order(&orders, 16);
+//     insertArray_Order(&orders, o);
+//     removeArray_Order(&orders, o);
+//     freeArray_Order(&orders);
+
+#ifndef ADS_EQUAL
+#define ADS_EQUAL(a, b) ((a) == (b))
+#endif
+
+/******************************************************
+ ***************** TEMPLATE ***************************
+ ******************************************************/
+#define DEFINE_ARRAY(T)                                                         \
+typedef struct {                                                                \
+    /* n is the number of elements in the array and size */                     \
+    /* the number of elements allocated. */                                     \
+    T *info;                                                                    \
+    int n, size;                                                                \
+} Array_##T;                                                                    \
+                                                                                \
+/* Allocates the array to hold size elements. Returns 1 on */                   \
+/* success and 0 if there is no memory, keeping the old one. */                 \
+static inline int resizeArray_##T(Array_##T *array, int size) {                 \
+    T *allocResult = (T *) realloc(array->info, sizeof(T) * (size > 0 ? size : 1)); \
+                                                                                \
+    if (!allocResult) {                                                         \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    array->info = allocResult;                                                  \
+    array->size = size;                                                         \
+                                                                                \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Creates an empty array with room for n elements. */                          \
+static inline int createArray_##T(Array_##T *array, int n) {                    \
+    if (!array) {                                                               \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    array->info = NULL;                                                         \
+    array->n = 0;                                                               \
+                                                                                \
+    return resizeArray_##T(array, n);                                           \
+}                                                                               \
+                                                                                \
+/* Frees the memory used by the array. */                                       \
+static inline void freeArray_##T(Array_##T *array) {                            \
+    if (array) {                                                                \
+        free(array->info);                                                      \
+        array->info = NULL;                                                     \
+        array->n = array->size = 0;                                             \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+/* Inserts an element in a position between 0 and n, moving */                  \
+/* the next ones to the right. The array grows by 25% when */                   \
+/* full. Returns 1 on success and 0 on error. */                                \
+static inline int insertArrayAt_##T(Array_##T *array, T elem, int pos) {        \
+    if (!array || pos < 0 || pos > array->n) {                                  \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    if (array->n == array->size                                                 \
+            && !resizeArray_##T(array, array->size + array->size / 4 + 1)) {    \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    memmove(array->info + pos + 1, array->info + pos,                           \
+        sizeof(T) * (array->n - pos));                                          \
+    array->info[pos] = elem;                                                    \
+    array->n++;                                                                 \
+                                                                                \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Inserts an element in the end of the array. */                               \
+static inline int insertArray_##T(Array_##T *array, T elem) {                   \
+    return array ? insertArrayAt_##T(array, elem, array->n) : 0;                \
+}                                                                               \
+                                                                                \
+/* Halves the memory of the array if it is less than 25% */                     \
+/* occupied. A failed shrink leaves the array as it was. */                     \
+static inline int shrinkArray_##T(Array_##T *array) {                           \
+    if (array->n < array->size / 4) {                                           \
+        return resizeArray_##T(array, array->size / 2);                         \
+    }                                                                           \
+                                                                                \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Removes the element in a position, moving the last element */                \
+/* to its place. Returns 1 on success and 0 on error. */                        \
+static inline int removeArrayAt_##T(Array_##T *array, int pos) {                \
+    if (!array || pos < 0 || pos >= array->n) {                                 \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    array->n--;                                                                 \
+    array->info[pos] = array->info[array->n];                                   \
+                                                                                \
+    return shrinkArray_##T(array);                                              \
+}                                                                               \
+                                                                                \
+/* Removes the element in a position, keeping the others in */                  \
+/* their relative order. Returns 1 on success and 0 on error. */                \
+static inline int removeArrayAtStable_##T(Array_##T *array, int pos) {          \
+    if (!array || pos < 0 || pos >= array->n) {                                 \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    array->n--;                                                                 \
+    memmove(array->info + pos, array->info + pos + 1,                           \
+        sizeof(T) * (array->n - pos));                                          \
+                                                                                \
+    return shrinkArray_##T(array);                                              \
+}                                                                               \
+                                                                                \
+/* Swaps two elements, assuming both positions are in bounds. */                \
+static inline void swapElements_##T(Array_##T *array, int i, int j) {           \
+    T aux = array->info[i];                                                     \
+                                                                                \
+    array->info[i] = array->info[j];                                            \
+    array->info[j] = aux;                                                       \
+}
+
+#define DEFINE_ARRAY_SEARCH(T, equal)                                           \
+/* Returns the position of the first element equal to elem, */                  \
+/* or -1 if there is none. */                                                   \
+static inline int findArray_##T(const Array_##T *array, T elem) {               \
+    int i;                                                                      \
+                                                                                \
+    for (i = 0; i < array->n; i++) {                                            \
+        if (equal(array->info[i], elem)) {                                      \
+            return i;                                                           \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    return -1;                                                                  \
+}                                                                               \
+                                                                                \
+/* Removes the first element equal to elem, if any, moving */                   \
+/* the last element to its place. Returns 0 on error. */                        \
+static inline int removeArray_##T(Array_##T *array, T elem) {                   \
+    int i;                                                                      \
+                                                                                \
+    if (!array) {                                                               \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    i = findArray_##T(array, elem);                                             \
+                                                                                \
+    return i < 0 ? 1 : removeArrayAt_##T(array, i);                             \
+}                                                                               \
+                                                                                \
+/* Removes the first element equal to elem, if any, keeping */                  \
+/* the others in their relative order. Returns 0 on error. */                   \
+static inline int removeArrayStable_##T(Array_##T *array, T elem) {             \
+    int i;                                                                      \
+                                                                                \
+    if (!array) {                                                               \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    i = findArray_##T(array, elem);                                             \
+                                                                                \
+    return i < 0 ? 1 : removeArrayAtStable_##T(array, i);                       \
+}
+
+#endif // DYNAMIC_ARRAY_TEMPLATE_H
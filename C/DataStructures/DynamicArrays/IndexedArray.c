@@ -0,0 +1,117 @@
+#include "IndexedArray.h"
+
+/******************************************************
+ ***************** MEMORY MANAGEMENT ******************
+ ******************************************************/
+/**
+ * Creates an empty indexed array with room for n values.
+ *
+ * @param indexed: A pointer to the indexed array to be
+ * initialized.
+ * @param n: The initial size of the array, at least 1.
+ * @return 1 if successful, 0 if memory could not be allocated.
+ */
+int createIndexedArray(IndexedArray *indexed, int n) {
+    if (!indexed || n < 1 || !createArray(&indexed->array, n)) {
+        return 0;
+    }
+
+    if (!createHashTable(&indexed->positions, n, HASH_TABLE_DEFAULT_LOAD_FACTOR)) {
+        freeArray(&indexed->array);
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * Frees the memory used by the indexed array.
+ *
+ * @param indexed: A pointer to the indexed array.
+ */
+void freeIndexedArray(IndexedArray *indexed) {
+    if (indexed) {
+        freeArray(&indexed->array);
+        freeHashTable(&indexed->positions);
+    }
+}
+
+/******************************************************
+ ***************** BASIC OPERATIONS *******************
+ ******************************************************/
+/**
+ * Inserts a value in the end of the array.
+ *
+ * @param indexed: A pointer to the indexed array.
+ * @param elem: The value to be inserted.
+ * @return 1 if the value was inserted, 0 if it was already
+ * there or memory could not be allocated.
+ */
+int insertIndexedArray(IndexedArray *indexed, int elem) {
+    int n;
+
+    if (!indexed || findHashTable(&indexed->positions, elem, NULL)) {
+        return 0;
+    }
+
+    n = indexed->array.n;
+    if (!insertHashTable(&indexed->positions, elem, n)) {
+        return 0;
+    }
+
+    if (!insertArray(&indexed->array, elem)) {
+        eraseHashTable(&indexed->positions, elem);
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * Removes a value from the array, in O(1) expected time.
+ *
+ * The last value takes its position, as in removeArrayAt, so
+ * the position of that value is updated in the index.
+ *
+ * @param indexed: A pointer to the indexed array.
+ * @param elem: The value to be removed.
+ * @return 1 if the value was found and removed, 0 otherwise.
+ */
+int removeIndexedArray(IndexedArray *indexed, int elem) {
+    int pos, last;
+
+    if (!indexed || !findHashTable(&indexed->positions, elem, &pos)) {
+        return 0;
+    }
+
+    // The value is erased first, so updating the position of the
+    // last one never makes the table grow.
+    eraseHashTable(&indexed->positions, elem);
+    last = indexed->array.info[indexed->array.n - 1];
+    if (last != elem) {
+        insertHashTable(&indexed->positions, last, pos);
+    }
+
+    // Shrinking the array may fail, but the value is removed
+    // anyway.
+    removeArrayAt(&indexed->array, pos);
+
+    return 1;
+}
+
+/**
+ * Searches for a value in the array, in O(1) expected time.
+ *
+ * @param indexed: A pointer to the indexed array.
+ * @param elem: The value to be searched.
+ * @param pos: A pointer to store the position of the value,
+ * or NULL.
+ * @return 1 if the value is in the array, 0 otherwise.
+ */
+int findIndexedArray(IndexedArray *indexed, int elem, int *pos) {
+    if (!indexed) {
+        return 0;
+    }
+
+    return findHashTable(&indexed->positions, elem, pos);
+}
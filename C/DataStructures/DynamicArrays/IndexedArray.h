@@ -0,0 +1,36 @@
+#ifndef INDEXED_ARRAY_H
+#define INDEXED_ARRAY_H
+
+#include "DynamicArray.h"
+#include "../HashTables/RobinHood/HashTable.h"
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Indexed arrays are dynamic arrays of distinct ints with a hash
+// table mapping each value to its position, so searching for a
+// value and removing it take O(1) expected time instead of the
+// linear scan of removeArray. Removals move the last value into
+// the hole, as removeArrayAt does, and update its position.
+
+typedef struct indexedArray {
+    // Defines an indexed array. array holds the values and
+    // positions maps each one to its index in array.info.
+    Array array;
+    HashTable positions;
+} IndexedArray;
+
+// Exported names.
+#define createIndexedArray ads_iarray_createIndexedArray
+#define freeIndexedArray   ads_iarray_freeIndexedArray
+#define insertIndexedArray ads_iarray_insertIndexedArray
+#define removeIndexedArray ads_iarray_removeIndexedArray
+#define findIndexedArray   ads_iarray_findIndexedArray
+
+int createIndexedArray(IndexedArray *indexed, int n);
+void freeIndexedArray(IndexedArray *indexed);
+int insertIndexedArray(IndexedArray *indexed, int elem);
+int removeIndexedArray(IndexedArray *indexed, int elem);
+int findIndexedArray(IndexedArray *indexed, int elem, int *pos);
+
+#endif // INDEXED_ARRAY_H
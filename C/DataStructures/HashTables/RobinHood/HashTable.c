@@ -0,0 +1,510 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "HashTable.h"
+
+// Greatest distance representable in a slot. Longer probe
+// sequences make the table grow.
+#define MAX_DISTANCE 255
+
+// Most slots of a table, so doubling never overflows an int.
+#define MAX_SIZE (1 << 30)
+
+// Long probe sequences only make the table grow while at least
+// 1 slot in SPARSE_FACTOR is occupied. In emptier tables they
+// come from keys sharing their home slot, which they do at every
+// size, so the insertion fails instead.
+#define SPARSE_FACTOR 8
+
+// Keys searched at the same time by findManyHashTable, about as
+// many cache misses as a core can wait on at once.
+#define FIND_GROUP 16
+
+/******************************************************
+ ***************** HASHING ****************************
+ ******************************************************/
+/**
+ * Computes the home slot of a key.
+ *
+ * It uses Fibonacci hashing: the key is multiplied by 2^32
+ * divided by the golden ratio and the highest bits of the
+ * product are taken, which spreads sequential keys well.
+ *
+ * @param table: A pointer to the hash table.
+ * @param key: The key to be hashed.
+ * @return the index of the key home slot.
+ */
+static int hash(HashTable *table, int key) {
+    return (int) (((unsigned int) key * 2654435769u) >> table->shift);
+}
+
+/******************************************************
+ ***************** MEMORY MANAGEMENT ******************
+ ******************************************************/
+/**
+ * Allocates empty slot arrays for the table.
+ *
+ * @param table: A pointer to the hash table.
+ * @param size: The number of slots, a power of 2.
+ * @return 1 if successful, 0 otherwise.
+ */
+static int allocSlots(HashTable *table, int size) {
+    int bits;
+
+    table->keys = (int *) malloc(sizeof(int) * size);
+    table->values = (int *) malloc(sizeof(int) * size);
+    table->distances = (unsigned char *) calloc(size, sizeof(unsigned char));
+
+    if (!table->keys || !table->values || !table->distances) {
+        free(table->keys);
+        free(table->values);
+        free(table->distances);
+
+        return 0;
+    }
+
+    for (bits = 0; (1 << bits) < size; bits++);
+
+    table->n = 0;
+    table->size = size;
+    table->shift = 32 - bits;
+
+    return 1;
+}
+
+/**
+ * Computes the number of slots needed to hold n keys.
+ *
+ * @param size: The number of slots to start from, a power of 2.
+ * @param n: The number of keys.
+ * @param maxLoadFactor: The maximum fraction of occupied slots.
+ * @return the least power of 2 not lesser than size that holds
+ * n keys, or 0 if it is over MAX_SIZE.
+ */
+static int slotsFor(int size, int n, double maxLoadFactor) {
+    while (size * maxLoadFactor < n) {
+        if (size >= MAX_SIZE) {
+            return 0;
+        }
+        size *= 2;
+    }
+
+    return size;
+}
+
+/**
+ * Creates a new hash table able to hold n keys without growing.
+ *
+ * @param table: A pointer to the hash table to be initialized.
+ * @param n: The number of keys expected.
+ * @param maxLoadFactor: The maximum fraction of occupied slots,
+ * between 0 and 1. Anything else selects the default value.
+ * @return an int representing the success of the memory allocation.
+ * It returns 0 in case of error and 1 in case of success.
+ */
+int createHashTable(HashTable *table, int n, double maxLoadFactor) {
+    int size;
+
+    if (!table) {
+        return 0;
+    }
+
+    if (maxLoadFactor <= 0 || maxLoadFactor >= 1) {
+        maxLoadFactor = HASH_TABLE_DEFAULT_LOAD_FACTOR;
+    }
+
+    table->maxLoadFactor = maxLoadFactor;
+
+    if (!(size = slotsFor(8, n, maxLoadFactor))) {
+        return 0;
+    }
+
+    return allocSlots(table, size);
+}
+
+/**
+ * Frees the memory used by the hash table.
+ *
+ * @param table: A pointer to the hash table.
+ */
+void freeHashTable(HashTable *table) {
+    if (table) {
+        free(table->keys);
+        free(table->values);
+        free(table->distances);
+    }
+}
+
+/******************************************************
+ ***************** BASIC OPERATIONS *******************
+ ******************************************************/
+static int resizeHashTable(HashTable *table, int size);
+static int findSlot(HashTable *table, int key, int i);
+
+/**
+ * Effectively inserts a key in the table.
+ *
+ * It walks from the key home slot and, Robin Hood style,
+ * takes the slot of any key closer to its own home than
+ * the one being inserted, which goes on looking for a slot.
+ * This keeps probe sequences short and evenly sized.
+ *
+ * The walk is first done without writing, to find whether the
+ * key is already there and whether the probe sequence would
+ * get too long. In that case the table grows before anything
+ * is moved, so no key is ever left out of it. It does not grow
+ * past MAX_SIZE, nor when it is sparse.
+ *
+ * @param table: A pointer to the hash table.
+ * @param key: The key to be inserted.
+ * @param value: The value associated to the key.
+ * @return 1 if successful, 0 if memory could not be allocated
+ * or the table could not grow.
+ */
+static int insertUtil(HashTable *table, int key, int value) {
+    int i, first, aux, mask;
+    unsigned char d, firstDistance, auxDistance;
+
+    mask = table->size - 1;
+    i = hash(table, key);
+    d = 1;
+    first = -1;
+    firstDistance = 0;
+
+    while (table->distances[i]) {
+        // If the key is already there, just updates its value.
+        if (table->distances[i] == d && table->keys[i] == key) {
+            table->values[i] = value;
+
+            return 1;
+        }
+
+        // From here on, the key in hand would be the one taken
+        // from this slot.
+        if (table->distances[i] < d) {
+            if (first < 0) {
+                first = i;
+                firstDistance = d;
+            }
+            d = table->distances[i];
+        }
+
+        i = (i+1) & mask;
+        d++;
+
+        if (d == MAX_DISTANCE) {
+            if (table->size >= MAX_SIZE || (long) table->n * SPARSE_FACTOR < table->size
+                    || !resizeHashTable(table, table->size * 2)) {
+                return 0;
+            }
+
+            return insertUtil(table, key, value);
+        }
+    }
+
+    // Takes the slots from the keys closer to their homes, from
+    // the first one found.
+    if (first >= 0) {
+        d = firstDistance;
+        for (i = first; table->distances[i]; i = (i+1) & mask, d++) {
+            if (table->distances[i] < d) {
+                aux = table->keys[i];
+                table->keys[i] = key;
+                key = aux;
+
+                aux = table->values[i];
+                table->values[i] = value;
+                value = aux;
+
+                auxDistance = table->distances[i];
+                table->distances[i] = d;
+                d = auxDistance;
+            }
+        }
+    }
+
+    table->keys[i] = key;
+    table->values[i] = value;
+    table->distances[i] = d;
+    table->n++;
+
+    return 1;
+}
+
+/**
+ * Moves all keys to a new set of slots.
+ *
+ * @param table: A pointer to the hash table.
+ * @param size: The new number of slots, a power of 2.
+ * @return 1 if successful, 0 otherwise.
+ */
+static int resizeHashTable(HashTable *table, int size) {
+    HashTable old = *table;
+    int i;
+
+    if (!allocSlots(table, size)) {
+        *table = old;
+
+        return 0;
+    }
+
+    // A key left out, when the table could not grow again,
+    // leaves the table as it was.
+    for (i = 0; i < old.size; i++) {
+        if (old.distances[i] && !insertUtil(table, old.keys[i], old.values[i])) {
+            freeHashTable(table);
+            *table = old;
+
+            return 0;
+        }
+    }
+
+    freeHashTable(&old);
+
+    return 1;
+}
+
+/**
+ * Grows the table so it can hold n keys without growing again.
+ *
+ * @param table: A pointer to the hash table.
+ * @param n: The number of keys expected.
+ * @return 1 if successful, 0 if memory could not be allocated
+ * or n needs more than MAX_SIZE slots.
+ */
+int reserveHashTable(HashTable *table, int n) {
+    int size;
+
+    if (!table) {
+        return 0;
+    }
+
+    if (!(size = slotsFor(table->size, n, table->maxLoadFactor))) {
+        return 0;
+    }
+
+    if (size == table->size) {
+        return 1;
+    }
+
+    return resizeHashTable(table, size);
+}
+
+/**
+ * Inserts a key and its value in the table.
+ *
+ * If the key is already in the table, its value is replaced,
+ * which never grows the table. Otherwise, if the load factor
+ * would go over the maximum, the number of slots is doubled
+ * first.
+ *
+ * @param table: A pointer to the hash table.
+ * @param key: The key to be inserted.
+ * @param value: The value associated to the key.
+ * @return 1 if successful, 0 if memory could not be allocated
+ * or too many keys share their home slot. The table is left
+ * as it was then.
+ */
+int insertHashTable(HashTable *table, int key, int value) {
+    int i;
+
+    if (!table) {
+        return 0;
+    }
+
+    if ((i = findSlot(table, key, hash(table, key))) >= 0) {
+        table->values[i] = value;
+        return 1;
+    }
+
+    if (table->n + 1 > table->size * table->maxLoadFactor) {
+        if (table->size >= MAX_SIZE || !resizeHashTable(table, table->size * 2)) {
+            return 0;
+        }
+    }
+
+    return insertUtil(table, key, value);
+}
+
+/**
+ * Searches for the slot holding a key.
+ *
+ * The search stops as soon as it reaches a slot whose key is
+ * closer to its home than the searched one would be, since
+ * Robin Hood insertion would have placed the key before it.
+ *
+ * @param table: A pointer to the hash table.
+ * @param key: The key to be searched.
+ * @param i: The index of the key home slot.
+ * @return the index of the slot, or -1 if the key is not there.
+ */
+static int findSlot(HashTable *table, int key, int i) {
+    int mask;
+    unsigned char d;
+
+    mask = table->size - 1;
+    d = 1;
+
+    while (table->distances[i] >= d) {
+        if (table->distances[i] == d && table->keys[i] == key) {
+            return i;
+        }
+
+        i = (i+1) & mask;
+        d++;
+    }
+
+    return -1;
+}
+
+/**
+ * Searches for a key in the table.
+ *
+ * If found, the value associated to the key is stored in the
+ * pointer received by parameter, unless it is NULL.
+ *
+ * @param table: A pointer to the hash table.
+ * @param key: The key to be searched.
+ * @param value: A pointer to store the key value, or NULL.
+ * @return 1 if the key is in the table, 0 otherwise.
+ */
+int findHashTable(HashTable *table, int key, int *value) {
+    int i;
+
+    if (!table) {
+        return 0;
+    }
+
+    i = findSlot(table, key, hash(table, key));
+
+    if (i < 0) {
+        return 0;
+    }
+
+    if (value) {
+        *value = table->values[i];
+    }
+
+    return 1;
+}
+
+/**
+ * Searches for many keys in the table at once (see
+ * findHashTable).
+ *
+ * Keys are searched in groups of FIND_GROUP, in stages: the
+ * home slots of the whole group are prefetched first, then
+ * probed, and then the values found are prefetched and read.
+ * So the cache misses of each stage overlap, instead of
+ * following one another as in one search after another. Most
+ * probes end in the cache line of the home slot.
+ *
+ * @param table: A pointer to the hash table.
+ * @param keys: A pointer to the keys to be searched.
+ * @param n: The number of keys.
+ * @param found: A pointer to store, for each key, 1 if it is
+ * in the table and 0 otherwise.
+ * @param values: A pointer to store the value of each key
+ * found, or NULL.
+ * @return the number of keys found.
+ */
+long findManyHashTable(HashTable *table, const int *keys, long n, int *found, int *values) {
+    int slots[FIND_GROUP];
+    long first, count = 0;
+    int j, m;
+
+    if (!table || !found) {
+        return 0;
+    }
+
+    for (first = 0; first < n; first += FIND_GROUP) {
+        m = n - first < FIND_GROUP ? n - first : FIND_GROUP;
+
+        for (j = 0; j < m; j++) {
+            slots[j] = hash(table, keys[first + j]);
+            __builtin_prefetch(&table->distances[slots[j]]);
+            __builtin_prefetch(&table->keys[slots[j]]);
+        }
+
+        for (j = 0; j < m; j++) {
+            slots[j] = findSlot(table, keys[first + j], slots[j]);
+            found[first + j] = slots[j] >= 0;
+            if (slots[j] >= 0) {
+                count++;
+                __builtin_prefetch(&table->values[slots[j]]);
+            }
+        }
+
+        for (j = 0; values && j < m; j++) {
+            if (slots[j] >= 0) {
+                values[first + j] = table->values[slots[j]];
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Removes a key from the table.
+ *
+ * Instead of leaving a tombstone, the keys after it in the
+ * probe sequence are shifted one slot back, until an empty
+ * slot or a key in its home slot is found.
+ *
+ * @param table: A pointer to the hash table.
+ * @param key: The key to be removed.
+ * @return 1 if the key was found and removed, 0 otherwise.
+ */
+int eraseHashTable(HashTable *table, int key) {
+    int i, next, mask;
+
+    if (!table) {
+        return 0;
+    }
+
+    i = findSlot(table, key, hash(table, key));
+
+    if (i < 0) {
+        return 0;
+    }
+
+    mask = table->size - 1;
+    next = (i+1) & mask;
+    while (table->distances[next] > 1) {
+        table->keys[i] = table->keys[next];
+        table->values[i] = table->values[next];
+        table->distances[i] = table->distances[next] - 1;
+
+        i = next;
+        next = (next+1) & mask;
+    }
+
+    table->distances[i] = 0;
+    table->n--;
+
+    return 1;
+}
+
+/******************************************************
+ ***************** OUTPUT *****************************
+ ******************************************************/
+/**
+ * Prints a representation of the hash table.
+ *
+ * It prints the key: value pairs in the order they appear
+ * in the slots.
+ *
+ * @param table: The hash table to be printed.
+ */
+void printHashTable(HashTable table) {
+    int i;
+
+    printf("size = %d e n = %d | ", table.size, table.n);
+    for (i = 0; i < table.size; i++) {
+        if (table.distances[i]) {
+            printf("%d: %d ", table.keys[i], table.values[i]);
+        }
+    }
+    printf("\n");
+}
@@ -0,0 +1,44 @@
+#ifndef HASH_TABLE_H
+#define HASH_TABLE_H
+
+// Default maximum fraction of occupied slots before the table grows.
+#define HASH_TABLE_DEFAULT_LOAD_FACTOR 0.875
+
+typedef struct hashTable {
+    // Defines an open-addressing hash table mapping int
+    // keys to int values, using Robin Hood hashing. The
+    // slots are stored as parallel arrays, so probing only
+    // touches keys and distances. A distance of 0 marks an
+    // empty slot, otherwise it is the slot distance to the
+    // key home position plus 1. n will store the number of
+    // keys and size the number of slots, always a power of 2.
+    //
+    // It can be used as a set, ignoring the values, or as
+    // an index over other containers, mapping each value
+    // stored in them to its position or count.
+    int *keys, *values;
+    unsigned char *distances;
+    int n, size, shift;
+    double maxLoadFactor;
+} HashTable;
+
+// Exported names.
+#define createHashTable   ads_hash_createHashTable
+#define freeHashTable     ads_hash_freeHashTable
+#define reserveHashTable  ads_hash_reserveHashTable
+#define insertHashTable   ads_hash_insertHashTable
+#define findHashTable     ads_hash_findHashTable
+#define findManyHashTable ads_hash_findManyHashTable
+#define eraseHashTable    ads_hash_eraseHashTable
+#define printHashTable    ads_hash_printHashTable
+
+int createHashTable(HashTable *table, int n, double maxLoadFactor);
+void freeHashTable(HashTable *table);
+int reserveHashTable(HashTable *table, int n);
+int insertHashTable(HashTable *table, int key, int value);
+int findHashTable(HashTable *table, int key, int *value);
+long findManyHashTable(HashTable *table, const int *keys, long n, int *found, int *values);
+int eraseHashTable(HashTable *table, int key);
+void printHashTable(HashTable table);
+
+#endif // HASH_TABLE_H
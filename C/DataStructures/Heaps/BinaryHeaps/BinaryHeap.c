@@ -1,8 +1,18 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
 
 #include "Heap.h"
 
+// Snapshots of max and min heaps are told apart, so neither
+// loads the other.
+#ifdef MIN_HEAP
+#define HEAP_SNAPSHOT SNAPSHOT_MIN_HEAP
+#else
+#define HEAP_SNAPSHOT SNAPSHOT_MAX_HEAP
+#endif
+
 /******************************************************
  ***************** MEMORY MANAGEMENT ******************
  ******************************************************/
@@ -88,7 +98,7 @@ int extractHeap(Heap *heap, int *top) {
 
     // Fix the heap.
     heap->n--;
-    fixDown(heap, 1);
+    fixDownHeap(heap, 1);
 
     if (heap->n < heap->size * 0.25) {
         allocResult = (int *) realloc(heap->info, sizeof(int) * heap->size * 0.5 + 1);
@@ -145,7 +155,7 @@ int insertHeap(Heap *heap, int elem) {
     heap->info[heap->n] = elem;
 
     // Fix the heap.
-    fixUp(heap, heap->n);
+    fixUpHeap(heap, heap->n);
 
     return 1;
 }
@@ -188,7 +198,7 @@ int removeHeap(Heap *heap, int elem) {
         heap->n--;
 
         // Fix the heap.
-        fixDown(heap, i);
+        fixDownHeap(heap, i);
 
         // Reallocates memory for the array of elements, if necessary.
         if (heap->n < heap->size * 0.25) {
@@ -206,6 +216,90 @@ int removeHeap(Heap *heap, int elem) {
     return 1;
 }
 
+/******************************************************
+ ***************** SNAPSHOTS **************************
+ ******************************************************/
+/**
+ * Saves the elements of the heap in a snapshot file
+ * (see Snapshot.h), in the order they appear in the
+ * storage array, so it is still a heap when mapped.
+ *
+ * @param heap: A pointer to the heap.
+ * @param path: The name of the file.
+ * @return 1 if successful, 0 otherwise.
+ */
+int saveHeap(const Heap *heap, const char *path) {
+    if (!heap) {
+        return 0;
+    }
+
+    return writeSnapshot(path, HEAP_SNAPSHOT, heap->info + 1, heap->n);
+}
+
+/**
+ * Maps a snapshot file of a heap, which is used in place.
+ *
+ * It takes O(1), no matter the size of the heap. The heap
+ * points into the snapshot, so no element can be inserted or
+ * extracted, and it must not be freed. In copy-on-write mode,
+ * elements can still be changed and fixed in place with
+ * fixUpHeap and fixDownHeap. Unmapping the snapshot ends it.
+ *
+ * @param heap: A pointer to the heap structure to be initialized.
+ * @param snapshot: A pointer to the snapshot to be mapped.
+ * @param path: The name of the file.
+ * @param mode: The mapping mode (see Snapshot.h).
+ * @return 1 if successful, 0 otherwise.
+ */
+int mapHeap(Heap *heap, Snapshot *snapshot, const char *path, int mode) {
+    if (!heap || !mapSnapshot(snapshot, path, HEAP_SNAPSHOT, mode)) {
+        return 0;
+    }
+
+    if (snapshot->n > INT_MAX) {
+        unmapSnapshot(snapshot);
+        return 0;
+    }
+
+    // Heap positions start at 1. Position 0 falls in the end of
+    // the snapshot header, which heaps never access.
+    heap->info = snapshot->info - 1;
+    heap->n = heap->size = snapshot->n;
+
+    return 1;
+}
+
+/**
+ * Loads a snapshot file of a heap into a new heap.
+ *
+ * It copies the elements, so the heap is an ordinary one.
+ * The snapshot is verified against its checksum.
+ *
+ * @param heap: A pointer to the heap structure to be initialized.
+ * @param path: The name of the file.
+ * @return 1 if successful, 0 otherwise.
+ */
+int loadHeap(Heap *heap, const char *path) {
+    Snapshot snapshot;
+    Heap mapped;
+
+    if (!mapHeap(&mapped, &snapshot, path, SNAPSHOT_READ_ONLY | SNAPSHOT_VERIFY)) {
+        return 0;
+    }
+
+    if (!createHeap(heap, mapped.n > 4 ? mapped.n : 4)) {
+        unmapSnapshot(&snapshot);
+        return 0;
+    }
+
+    memcpy(heap->info + 1, mapped.info + 1, sizeof(int) * mapped.n);
+    heap->n = mapped.n;
+
+    unmapSnapshot(&snapshot);
+
+    return 1;
+}
+
 /******************************************************
  ***************** OUTPUT *****************************
  ******************************************************/
@@ -217,7 +311,7 @@ int removeHeap(Heap *heap, int elem) {
  *
  * @param heap: The heap to be printed.
  */
-void print(Heap heap) {
+void printHeap(Heap heap) {
     int i, n;
 
     n = heap.n;
@@ -1,6 +1,11 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+// Always exported under the min heap prefix (see Heap.h).
+#ifndef MIN_HEAP
+#define MIN_HEAP
+#endif
+
 #include "Heap.h"
 
 /******************************************************
@@ -20,7 +25,7 @@
  * @param heap: A pointer to the heap.
  * @param k: The index of the last element to be rearranged.
  */
-void fixUp(Heap *heap, int k) {
+void fixUpHeap(Heap *heap, int k) {
     int aux;
 
     if (heap) {
@@ -51,7 +56,7 @@ void fixUp(Heap *heap, int k) {
  * @param heap: A pointer to the heap.
  * @param k: The index of the first element to be rearranged.
  */
-void fixDown(Heap *heap, int k) {
+void fixDownHeap(Heap *heap, int k) {
     int aux, n, i;
 
     if (heap) {
@@ -61,7 +66,7 @@ void fixDown(Heap *heap, int k) {
         i = 2*k;
         while (i <= n) {
             // Chooses the lesser sibling among k children.
-            if (heap->info[i] > heap->info[i+1]) {
+            if (i < n && heap->info[i] > heap->info[i+1]) {
                 i = i+1;
             }
 
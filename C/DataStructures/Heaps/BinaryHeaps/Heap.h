@@ -1,3 +1,8 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include "../../Snapshots/Snapshot.h"
+
 typedef struct heap {
     // Defines a heap of ints. n will store the
     // number of elements in the heap and size
@@ -6,11 +11,48 @@ typedef struct heap {
     int *info, n, size;
 } Heap;
 
+// Exported names. Max and min heaps share every function but
+// fixUpHeap and fixDownHeap, so the library has both variants, each one
+// under its own prefix. Code using the min heap, including
+// BinaryHeap.c when built along BinaryMinHeap.c, must be compiled
+// with -DMIN_HEAP.
+#ifdef MIN_HEAP
+#define HEAP_SYMBOL(name) ads_minheap_##name
+#else
+#define HEAP_SYMBOL(name) ads_maxheap_##name
+#endif
+
+#define createHeap  HEAP_SYMBOL(createHeap)
+#define freeHeap    HEAP_SYMBOL(freeHeap)
+#define fixUpHeap   HEAP_SYMBOL(fixUpHeap)
+#define fixDownHeap HEAP_SYMBOL(fixDownHeap)
+#define extractHeap HEAP_SYMBOL(extractHeap)
+#define insertHeap  HEAP_SYMBOL(insertHeap)
+#define removeHeap  HEAP_SYMBOL(removeHeap)
+#define printHeap   HEAP_SYMBOL(printHeap)
+#define saveHeap    HEAP_SYMBOL(saveHeap)
+#define mapHeap     HEAP_SYMBOL(mapHeap)
+#define loadHeap    HEAP_SYMBOL(loadHeap)
+
 int createHeap(Heap *heap, int n);
 void freeHeap(Heap *heap);
-void fixUp(Heap *heap, int k);
-void fixDown(Heap *heap, int k);
+void fixUpHeap(Heap *heap, int k);
+void fixDownHeap(Heap *heap, int k);
 int extractHeap(Heap *heap, int *top);
 int insertHeap(Heap *heap, int elem);
 int removeHeap(Heap *heap, int elem);
-void print(Heap heap);
+void printHeap(Heap heap);
+int saveHeap(const Heap *heap, const char *path);
+int mapHeap(Heap *heap, Snapshot *snapshot, const char *path, int mode);
+int loadHeap(Heap *heap, const char *path);
+
+// The names fixUpHeap and fixDownHeap had before, for code written
+// against them. They are common words, so they are opt-in. print,
+// the old name of printHeap, is not among them: DynamicArray.h
+// used it too.
+#ifdef ADS_SHORT_NAMES
+#define fixUp   fixUpHeap
+#define fixDown fixDownHeap
+#endif
+
+#endif // HEAP_H
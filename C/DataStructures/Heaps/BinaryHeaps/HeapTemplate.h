@@ -0,0 +1,224 @@
+#ifndef HEAP_TEMPLATE_H
+#define HEAP_TEMPLATE_H
+
+#include <stdlib.h>
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Binary heaps of keys of any type, each one with a value of
+// any type. DEFINE_HEAP(K, V, cmp) generates the type Heap_K_V
+// and its functions, named after the ones of the int heap
+// (Heap.h) followed by _K_V. They are static inline, so each
+// instantiation is compiled and inlined for its own types
+// where it is used. The int heaps in libads stay the default.
+//
+// Keys and values are kept in two arrays (structure of arrays)
+// moved in lockstep, so fixUpHeap and fixDownHeap only read
+// keys to compare, and a cache line holds as many keys as
+// possible however large the values are. Both move a hole
+// along the path instead of swapping, so each level writes one
+// key and one value.
+//
+// The greatest key by cmp is on top, as in the max heap, so
+// min heaps pass a reversed comparison, e.g. ADS_REVERSE_COMPARE.
+// K and V must be single identifiers, so types such as
+// unsigned long or structs need a typedef first. cmp(a, b)
+// may be a macro or a function, and returns a negative number,
+// zero or a positive number when a is lesser than, equal to
+// or greater than b, as strcmp. ADS_COMPARE does it for
+// numbers. As in the int heap, positions go from 1 to n.
+//
+// Example:
+//
+//     typedef struct {
+//         int id;
+//         char name[28];
+//     } Job;
+//
+//     DEFINE_HEAP(long, Job, ADS_REVERSE_COMPARE)
+//
+//     Heap_long_Job jobs;
+//     long deadline;
+//     Job job = {1, "backup"};
+//
+//     createHeap_long_Job(&jobs, 64);
+//     insertHeap_long_Job(&jobs, 1700000000, job);
+//     extractHeap_long_Job(&jobs, &deadline, &job);
+//     freeHeap_long_Job(&jobs);
+
+#ifndef ADS_COMPARE
+#define ADS_COMPARE(a, b) (((a) > (b)) - ((a) < (b)))
+#endif
+
+#ifndef ADS_REVERSE_COMPARE
+#define ADS_REVERSE_COMPARE(a, b) ADS_COMPARE(b, a)
+#endif
+
+/******************************************************
+ ***************** TEMPLATE ***************************
+ ******************************************************/
+#define DEFINE_HEAP(K, V, cmp)                                                  \
+typedef struct {                                                                \
+    /* keys[i] and values[i] are the element in position i, */                  \
+    /* from 1 to n. size is the number of elements allocated. */                \
+    K *keys;                                                                    \
+    V *values;                                                                  \
+    int n, size;                                                                \
+} Heap_##K##_##V;                                                               \
+                                                                                \
+/* Allocates both arrays to hold size elements. Returns 1 on */                 \
+/* success and 0 if there is no memory, keeping the old ones. */                \
+static inline int resizeHeap_##K##_##V(Heap_##K##_##V *heap, int size) {        \
+    K *keys = (K *) realloc(heap->keys, sizeof(K) * (size + 1));                \
+    V *values;                                                                  \
+                                                                                \
+    if (!keys) {                                                                \
+        return 0;                                                               \
+    }                                                                           \
+    heap->keys = keys;                                                          \
+                                                                                \
+    values = (V *) realloc(heap->values, sizeof(V) * (size + 1));               \
+    if (!values) {                                                              \
+        if (size < heap->size) { /* The keys shrank already. */                 \
+            heap->size = size;                                                  \
+        }                                                                       \
+        return 0;                                                               \
+    }                                                                           \
+    heap->values = values;                                                      \
+    heap->size = size;                                                          \
+                                                                                \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Creates an empty heap with room for n elements. */                           \
+static inline int createHeap_##K##_##V(Heap_##K##_##V *heap, int n) {           \
+    if (!heap) {                                                                \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    heap->keys = NULL;                                                          \
+    heap->values = NULL;                                                        \
+    heap->n = heap->size = 0;                                                   \
+                                                                                \
+    if (!resizeHeap_##K##_##V(heap, n)) {                                       \
+        free(heap->keys);                                                       \
+        heap->keys = NULL;                                                      \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Frees the memory used by the heap. */                                        \
+static inline void freeHeap_##K##_##V(Heap_##K##_##V *heap) {                   \
+    if (heap) {                                                                 \
+        free(heap->keys);                                                       \
+        free(heap->values);                                                     \
+        heap->keys = NULL;                                                      \
+        heap->values = NULL;                                                    \
+        heap->n = heap->size = 0;                                               \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+/* Moves the k-th element up while it is greater than its */                    \
+/* parent. */                                                                   \
+static inline void fixUpHeap_##K##_##V(Heap_##K##_##V *heap, int k) {               \
+    K key = heap->keys[k];                                                      \
+    V value = heap->values[k];                                                  \
+                                                                                \
+    while (k > 1 && cmp(key, heap->keys[k/2]) > 0) {                            \
+        heap->keys[k] = heap->keys[k/2];                                        \
+        heap->values[k] = heap->values[k/2];                                    \
+        k /= 2;                                                                 \
+    }                                                                           \
+                                                                                \
+    heap->keys[k] = key;                                                        \
+    heap->values[k] = value;                                                    \
+}                                                                               \
+                                                                                \
+/* Moves the k-th element down while it is lesser than its */                   \
+/* greater child. */                                                            \
+static inline void fixDownHeap_##K##_##V(Heap_##K##_##V *heap, int k) {             \
+    K key = heap->keys[k];                                                      \
+    V value = heap->values[k];                                                  \
+    int i, n = heap->n;                                                         \
+                                                                                \
+    for (i = 2*k; i <= n; k = i, i *= 2) {                                      \
+        if (i < n && cmp(heap->keys[i], heap->keys[i+1]) < 0) {                 \
+            i++;                                                                \
+        }                                                                       \
+                                                                                \
+        if (cmp(key, heap->keys[i]) >= 0) {                                     \
+            break;                                                              \
+        }                                                                       \
+                                                                                \
+        heap->keys[k] = heap->keys[i];                                          \
+        heap->values[k] = heap->values[i];                                      \
+    }                                                                           \
+                                                                                \
+    heap->keys[k] = key;                                                        \
+    heap->values[k] = value;                                                    \
+}                                                                               \
+                                                                                \
+/* Inserts an element. The heap grows by 25% when full. */                      \
+/* Returns 1 on success and 0 on error. */                                      \
+static inline int insertHeap_##K##_##V(Heap_##K##_##V *heap, K key, V value) {  \
+    if (!heap) {                                                                \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    if (heap->n == heap->size                                                   \
+            && !resizeHeap_##K##_##V(heap, heap->size + heap->size / 4 + 1)) {  \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    heap->n++;                                                                  \
+    heap->keys[heap->n] = key;                                                  \
+    heap->values[heap->n] = value;                                              \
+    fixUpHeap_##K##_##V(heap, heap->n);                                             \
+                                                                                \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Removes the element in position k, between 1 and n, storing */               \
+/* it in key and value unless they are NULL. The heap is halved */              \
+/* when less than 25% occupied. Returns 1 on success and 0 if */                \
+/* there is no such position. */                                                \
+static inline int removeHeapAt_##K##_##V(Heap_##K##_##V *heap, int k,          \
+        K *key, V *value) {                                                     \
+    if (!heap || k < 1 || k > heap->n) {                                        \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    if (key) {                                                                  \
+        *key = heap->keys[k];                                                   \
+    }                                                                           \
+    if (value) {                                                                \
+        *value = heap->values[k];                                               \
+    }                                                                           \
+                                                                                \
+    /* The last element takes its place, and may go either way. */              \
+    heap->keys[k] = heap->keys[heap->n];                                        \
+    heap->values[k] = heap->values[heap->n];                                    \
+    heap->n--;                                                                  \
+                                                                                \
+    if (k <= heap->n) {                                                         \
+        fixUpHeap_##K##_##V(heap, k);                                               \
+        fixDownHeap_##K##_##V(heap, k);                                             \
+    }                                                                           \
+                                                                                \
+    if (heap->n < heap->size / 4) {                                             \
+        resizeHeap_##K##_##V(heap, heap->size / 2); /* Kept as is if it fails. */ \
+    }                                                                           \
+                                                                                \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Removes the top element, storing it in key and value unless */               \
+/* they are NULL. Returns 1 on success and 0 if it is empty. */                 \
+static inline int extractHeap_##K##_##V(Heap_##K##_##V *heap, K *key, V *value) { \
+    return removeHeapAt_##K##_##V(heap, 1, key, value);                         \
+}
+
+#endif // HEAP_TEMPLATE_H
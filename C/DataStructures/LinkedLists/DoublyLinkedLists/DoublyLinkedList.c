@@ -184,7 +184,7 @@ Node *removeNode(Node *head, int info) {
     }
 
     // Searches for the provided value.
-    p2 = head;
+    p1 = p2 = head;
     while (p2->info != info && p2->next) {
         p1 = p2;
         p2 = p2->next;
@@ -310,7 +310,7 @@ Node *removeLastNode(Node *head) {
 Node *removeLastNodeRecursive(Node *head) {
     if (head) {
         if (head->next) {
-            head->next = lastNodeRecursive(head->next);
+            head->next = removeLastNodeRecursive(head->next);
         }
         else {
             free(head);
@@ -443,3 +443,512 @@ void printList(Node *head) {
     }
     printf("-\n");
 }
+
+/******************************************************
+ ***************** LIST HEADER OPERATIONS *************
+ ******************************************************/
+/**
+ * Initializes an empty list header.
+ *
+ * @param list: A pointer to the list header.
+ */
+void createList(List *list) {
+    if (list) {
+        list->head = list->tail = NULL;
+        list->size = 0;
+    }
+}
+
+/**
+ * Frees the memory used by the list nodes and empties
+ * the list header.
+ *
+ * @param list: A pointer to the list header.
+ */
+void clearList(List *list) {
+    if (list) {
+        freeList(list->head);
+        createList(list);
+    }
+}
+
+/**
+ * Inserts a new node in the end of the list in O(1).
+ *
+ * It assumes that the node already has memory already
+ * allocated. It does not perform any validation in the new
+ * node fields.
+ *
+ * @param list: A pointer to the list header.
+ * @param newNode: A pointer to the node to be inserted.
+ */
+void insertEndList(List *list, Node *newNode) {
+    newNode->next = NULL;
+    newNode->previous = list->tail;
+
+    if (list->tail) {
+        list->tail->next = newNode;
+    }
+    else {
+        list->head = newNode;
+    }
+
+    list->tail = newNode;
+    list->size++;
+}
+
+/**
+ * Inserts a new node in the beginning of the list.
+ *
+ * It assumes that the node already has memory already
+ * allocated. It does not perform any validation in the new
+ * node fields.
+ *
+ * @param list: A pointer to the list header.
+ * @param newNode: A pointer to the node to be inserted.
+ */
+void insertBeginningList(List *list, Node *newNode) {
+    newNode->previous = NULL;
+    newNode->next = list->head;
+
+    if (list->head) {
+        list->head->previous = newNode;
+    }
+    else {
+        list->tail = newNode;
+    }
+
+    list->head = newNode;
+    list->size++;
+}
+
+/**
+ * Unlinks a node from the list, without freeing it.
+ *
+ * It uses the node own pointers to reach its neighbours, so
+ * it takes O(1). It assumes the node belongs to the list.
+ *
+ * @param list: A pointer to the list header.
+ * @param node: A pointer to the node to be unlinked.
+ */
+static void unlinkNodeList(List *list, Node *node) {
+    if (node->previous) {
+        node->previous->next = node->next;
+    }
+    else {
+        list->head = node->next;
+    }
+
+    if (node->next) {
+        node->next->previous = node->previous;
+    }
+    else {
+        list->tail = node->previous;
+    }
+
+    node->next = node->previous = NULL;
+    list->size--;
+}
+
+/**
+ * Removes a node from the list, according to its info value.
+ *
+ * It searches for the first occurrence of a node that contains
+ * the given value in its info field and deletes it, also freeing
+ * the memory. If there is no occurrence, the list is not changed.
+ *
+ * @param list: A pointer to the list header.
+ * @param info: The value of the info to be removed.
+ * @return 1 if a node was removed, 0 otherwise.
+ */
+int removeNodeList(List *list, int info) {
+    Node *p;
+
+    // Searches for the provided value.
+    p = list->head;
+    while (p && p->info != info) {
+        p = p->next;
+    }
+
+    if (!p) {
+        return 0;
+    }
+
+    unlinkNodeList(list, p);
+
+    free(p);
+    p = NULL;
+
+    return 1;
+}
+
+/**
+ * Removes the first node from the list, i.e., its head.
+ *
+ * @param list: A pointer to the list header.
+ */
+void removeFirstNodeList(List *list) {
+    free(popFirstNodeList(list));
+}
+
+/**
+ * Removes the last node from the list in O(1).
+ *
+ * @param list: A pointer to the list header.
+ */
+void removeLastNodeList(List *list) {
+    free(popLastNodeList(list));
+}
+
+/**
+ * Returns a pointer to the last node of the list in O(1).
+ *
+ * @param list: A pointer to the list header.
+ * @return the pointer to the list last node.
+ */
+Node *lastNodeList(List *list) {
+    return list->tail;
+}
+
+/**
+ * Returns a pointer to the last node of the list and
+ * removes it from the list in O(1).
+ *
+ * @param list: A pointer to the list header.
+ * @return the pointer to the list last node.
+ */
+Node *popLastNodeList(List *list) {
+    Node *p = list->tail;
+
+    if (p) {
+        unlinkNodeList(list, p);
+    }
+
+    return p;
+}
+
+/**
+ * Returns a pointer to the first node of the list and
+ * removes it from the list.
+ *
+ * @param list: A pointer to the list header.
+ * @return the pointer to the list first node.
+ */
+Node *popFirstNodeList(List *list) {
+    Node *p = list->head;
+
+    if (p) {
+        unlinkNodeList(list, p);
+    }
+
+    return p;
+}
+
+/**
+ * Returns the number of nodes in the list in O(1).
+ *
+ * @param list: A pointer to the list header.
+ * @return the number of nodes.
+ */
+int sizeList(List *list) {
+    return list->size;
+}
+
+/******************************************************
+ ***************** SORTING OPERATIONS *****************
+ ******************************************************/
+/**
+ * Rebuilds the previous pointers of a list whose next
+ * pointers are correct.
+ *
+ * @param head: A pointer to the list head.
+ * @return the pointer to the list last node.
+ */
+static Node *fixPrevious(Node *head) {
+    Node *p, *prev;
+
+    prev = NULL;
+    for (p = head; p; p = p->next) {
+        p->previous = prev;
+        prev = p;
+    }
+
+    return prev;
+}
+
+/**
+ * Cuts the list after its first width nodes.
+ *
+ * @param head: A pointer to the list head.
+ * @param width: The number of nodes to be kept.
+ * @return the pointer to the head of the remaining nodes,
+ * or NULL if the list has width nodes or less.
+ */
+static Node *splitRun(Node *head, int width) {
+    Node *rest;
+
+    while (head && --width > 0) {
+        head = head->next;
+    }
+
+    if (!head) {
+        return NULL;
+    }
+
+    rest = head->next;
+    head->next = NULL;
+
+    return rest;
+}
+
+/**
+ * Merges two sorted runs, relinking their nodes.
+ *
+ * Ties are taken from the first run, so the merge is stable.
+ *
+ * @param a: A pointer to the head of the first run.
+ * @param b: A pointer to the head of the second run.
+ * @param last: A pointer to store the merged list last node.
+ * @return the pointer to the merged list head.
+ */
+static Node *mergeRuns(Node *a, Node *b, Node **last) {
+    Node dummy, *p;
+
+    p = &dummy;
+    while (a && b) {
+        if (b->info < a->info) {
+            p->next = b;
+            b = b->next;
+        }
+        else {
+            p->next = a;
+            a = a->next;
+        }
+
+        p = p->next;
+    }
+
+    p->next = a ? a : b;
+
+    // Walks the remaining run to find the merged list end.
+    while (p->next) {
+        p = p->next;
+    }
+
+    *last = p;
+
+    return dummy.next;
+}
+
+/**
+ * Effectively sorts the list, bottom-up.
+ *
+ * At each pass, it merges adjacent sorted runs of width nodes,
+ * doubling width until a single run remains. It does not use
+ * recursion nor extra memory besides a few pointers.
+ *
+ * @param head: A pointer to the list head.
+ * @param last: A pointer to store the sorted list last node.
+ * @return the pointer to the sorted list head.
+ */
+static Node *mergeSortUtil(Node *head, Node **last) {
+    Node dummy, *tail, *left, *right, *rest, *mergedLast;
+    int width, merges;
+
+    if (!head) {
+        *last = NULL;
+
+        return NULL;
+    }
+
+    dummy.next = head;
+
+    for (width = 1; ; width *= 2) {
+        rest = dummy.next;
+        tail = &dummy;
+        merges = 0;
+
+        // Merges each pair of adjacent runs and appends the result.
+        while (rest) {
+            left = rest;
+            right = splitRun(left, width);
+            rest = splitRun(right, width);
+
+            tail->next = mergeRuns(left, right, &mergedLast);
+            tail = mergedLast;
+            merges++;
+        }
+
+        // A pass with a single merge left the whole list sorted.
+        if (merges <= 1) {
+            break;
+        }
+    }
+
+    *last = fixPrevious(dummy.next);
+
+    return dummy.next;
+}
+
+/**
+ * Sorts the list in ascending order of info.
+ *
+ * It is a stable, in-place, bottom-up merge sort: nodes are
+ * relinked, never copied nor reallocated, in O(n log n) time
+ * and O(1) extra memory.
+ * The merge only follows the next pointers. The previous
+ * pointers are rebuilt afterwards in a single pass.
+ *
+ * @param head: A pointer to the list head.
+ * @return the pointer to the sorted list head.
+ */
+Node *mergeSort(Node *head) {
+    Node *last;
+
+    return mergeSortUtil(head, &last);
+}
+
+/**
+ * Sorts the list in ascending order of info, updating
+ * both ends of the list header.
+ *
+ * @param list: A pointer to the list header.
+ */
+void mergeSortList(List *list) {
+    list->head = mergeSortUtil(list->head, &(list->tail));
+}
+
+/**
+ * Merges two sorted lists into a single sorted list.
+ *
+ * Nodes are relinked in linear time. When both lists have
+ * nodes with the same info, the ones from the first list
+ * come first.
+ * Lists with a header must use mergeSortedListsList instead,
+ * which also keeps their tail and size.
+ *
+ * @param a: A pointer to the first list head.
+ * @param b: A pointer to the second list head.
+ * @return the pointer to the merged list head.
+ */
+Node *mergeSortedLists(Node *a, Node *b) {
+    Node *last, *head;
+
+    head = mergeRuns(a, b, &last);
+    fixPrevious(head);
+
+    return head;
+}
+
+/**
+ * Effectively removes repeated values from a sorted list.
+ *
+ * @param head: A pointer to the list head.
+ * @param last: A pointer to store the list last node.
+ * @return the number of nodes removed.
+ */
+static int dedupeSortedUtil(Node *head, Node **last) {
+    Node *p, *dup;
+    int removed;
+
+    removed = 0;
+    p = head;
+    while (p && p->next) {
+        if (p->next->info == p->info) {
+            dup = p->next;
+            p->next = dup->next;
+
+            if (p->next) {
+                p->next->previous = p;
+            }
+
+            free(dup);
+            dup = NULL;
+            removed++;
+        }
+        else {
+            p = p->next;
+        }
+    }
+
+    *last = p;
+
+    return removed;
+}
+
+/**
+ * Removes repeated values from a sorted list.
+ *
+ * It keeps the first node of each run of equal values and
+ * frees the others, in linear time.
+ * Lists with a header must use dedupeSortedList instead,
+ * which also keeps their tail and size.
+ *
+ * @param head: A pointer to the list head.
+ * @return the pointer to the modified list head.
+ */
+Node *dedupeSorted(Node *head) {
+    Node *last;
+
+    dedupeSortedUtil(head, &last);
+
+    return head;
+}
+
+/**
+ * Merges another sorted list into a sorted list, updating
+ * both ends and the size of its header.
+ *
+ * @param list: A pointer to the receiving list header.
+ * @param other: A pointer to the header of the list to be
+ * merged. It is left empty.
+ */
+void mergeSortedListsList(List *list, List *other) {
+    Node *last;
+
+    if (!other->head) {
+        return;
+    }
+
+    list->head = mergeRuns(list->head, other->head, &last);
+    list->tail = fixPrevious(list->head);
+    list->size += other->size;
+
+    createList(other);
+}
+
+/**
+ * Removes repeated values from a sorted list, updating
+ * its tail and size.
+ *
+ * @param list: A pointer to the list header.
+ */
+void dedupeSortedList(List *list) {
+    list->size -= dedupeSortedUtil(list->head, &(list->tail));
+}
+
+/**
+ * Moves all nodes of a list to the end of another in O(1).
+ *
+ * @param list: A pointer to the receiving list header.
+ * @param other: A pointer to the header of the list to be
+ * moved. It is left empty.
+ */
+void spliceLists(List *list, List *other) {
+    if (!other->head) {
+        return;
+    }
+
+    if (list->tail) {
+        list->tail->next = other->head;
+        other->head->previous = list->tail;
+    }
+    else {
+        list->head = other->head;
+    }
+
+    list->tail = other->tail;
+    list->size += other->size;
+
+    createList(other);
+}
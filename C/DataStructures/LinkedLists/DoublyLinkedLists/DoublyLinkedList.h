@@ -6,8 +6,52 @@ typedef struct node {
     int info;
 } Node;
 
+typedef struct list {
+    // Defines a list header. It keeps pointers to both
+    // ends of the list and the number of nodes in it, so
+    // operations on the tail do not traverse the list.
+    Node *head, *tail;
+    int size;
+} List;
+
 #endif // NODE_H
 
+// Exported names (see SinglyLinkedList.h).
+#define createNode              ads_dll_createNode
+#define freeList                ads_dll_freeList
+#define freeListRecursive       ads_dll_freeListRecursive
+#define insertEnd               ads_dll_insertEnd
+#define insertEndRecursive      ads_dll_insertEndRecursive
+#define insertBeginning         ads_dll_insertBeginning
+#define removeNode              ads_dll_removeNode
+#define removeNodeRecursive     ads_dll_removeNodeRecursive
+#define removeLastNode          ads_dll_removeLastNode
+#define removeLastNodeRecursive ads_dll_removeLastNodeRecursive
+#define lastNode                ads_dll_lastNode
+#define lastNodeRecursive       ads_dll_lastNodeRecursive
+#define popLastNode             ads_dll_popLastNode
+#define popFirstNode            ads_dll_popFirstNode
+#define printList               ads_dll_printList
+#define printListRecursive      ads_dll_printListRecursive
+#define createList              ads_dll_createList
+#define clearList               ads_dll_clearList
+#define insertEndList           ads_dll_insertEndList
+#define insertBeginningList     ads_dll_insertBeginningList
+#define removeNodeList          ads_dll_removeNodeList
+#define removeFirstNodeList     ads_dll_removeFirstNodeList
+#define removeLastNodeList      ads_dll_removeLastNodeList
+#define lastNodeList            ads_dll_lastNodeList
+#define popLastNodeList         ads_dll_popLastNodeList
+#define popFirstNodeList        ads_dll_popFirstNodeList
+#define sizeList                ads_dll_sizeList
+#define mergeSort               ads_dll_mergeSort
+#define mergeSortList           ads_dll_mergeSortList
+#define mergeSortedLists        ads_dll_mergeSortedLists
+#define dedupeSorted            ads_dll_dedupeSorted
+#define mergeSortedListsList    ads_dll_mergeSortedListsList
+#define dedupeSortedList        ads_dll_dedupeSortedList
+#define spliceLists             ads_dll_spliceLists
+
 Node *createNode(int info);
 void freeList(Node *head);
 void freeListRecursive(Node *head);
@@ -24,3 +68,21 @@ Node *popLastNode(Node **head);
 Node *popFirstNode(Node **head);
 void printList(Node *head);
 void printListRecursive(Node *head);
+void createList(List *list);
+void clearList(List *list);
+void insertEndList(List *list, Node *newNode);
+void insertBeginningList(List *list, Node *newNode);
+int removeNodeList(List *list, int info);
+void removeFirstNodeList(List *list);
+void removeLastNodeList(List *list);
+Node *lastNodeList(List *list);
+Node *popLastNodeList(List *list);
+Node *popFirstNodeList(List *list);
+int sizeList(List *list);
+Node *mergeSort(Node *head);
+void mergeSortList(List *list);
+Node *mergeSortedLists(Node *a, Node *b);
+Node *dedupeSorted(Node *head);
+void mergeSortedListsList(List *list, List *other);
+void dedupeSortedList(List *list);
+void spliceLists(List *list, List *other);
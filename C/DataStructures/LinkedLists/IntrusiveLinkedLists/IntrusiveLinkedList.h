@@ -0,0 +1,270 @@
+#ifndef INTRUSIVE_LINKED_LIST_H
+#define INTRUSIVE_LINKED_LIST_H
+
+#include <stddef.h>
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Intrusive lists do not own nodes. Instead, callers embed
+// a link field in their own structs and the list chains the
+// links together, so no extra allocation is needed per
+// element. The enclosing struct is recovered from a link
+// with container_of.
+//
+// Example:
+//
+//     typedef struct request {
+//         int id;
+//         ListLink link;
+//     } Request;
+//
+//     ListLink pending;
+//     Request *r;
+//
+//     listInit(&pending);
+//     listInsertEnd(&pending, &r->link);
+//     listForEachEntry(r, &pending, Request, link) {
+//         printf("%d\n", r->id);
+//     }
+
+/**
+ * Returns a pointer to the struct of the given type that
+ * contains the member pointed by ptr.
+ */
+#ifndef container_of
+#define container_of(ptr, type, member) \
+    ((type *) ((char *) (ptr) - offsetof(type, member)))
+#endif
+
+typedef struct listLink {
+    // Defines a doubly linked list link. Lists are circular
+    // and start at a sentinel link that is not embedded in
+    // any element, so no operation has special cases for
+    // the list ends.
+    struct listLink *next, *previous;
+} ListLink;
+
+typedef struct sListLink {
+    // Defines a singly linked list link. Lists start at a
+    // sentinel link and the last link points to NULL.
+    struct sListLink *next;
+} SListLink;
+
+/******************************************************
+ ***************** DOUBLY LINKED LISTS ****************
+ ******************************************************/
+/**
+ * Initializes an empty list, pointing the sentinel to itself.
+ *
+ * @param head: A pointer to the list sentinel.
+ */
+static inline void listInit(ListLink *head) {
+    head->next = head->previous = head;
+}
+
+/**
+ * Tells whether the list has no elements.
+ *
+ * @param head: A pointer to the list sentinel.
+ * @return 1 if the list is empty, 0 otherwise.
+ */
+static inline int listEmpty(const ListLink *head) {
+    return head->next == head;
+}
+
+/**
+ * Inserts a link right after another one.
+ *
+ * @param pos: A pointer to a link already in the list.
+ * @param link: A pointer to the link to be inserted.
+ */
+static inline void listInsertAfter(ListLink *pos, ListLink *link) {
+    link->previous = pos;
+    link->next = pos->next;
+    pos->next->previous = link;
+    pos->next = link;
+}
+
+/**
+ * Inserts a link right before another one.
+ *
+ * @param pos: A pointer to a link already in the list.
+ * @param link: A pointer to the link to be inserted.
+ */
+static inline void listInsertBefore(ListLink *pos, ListLink *link) {
+    listInsertAfter(pos->previous, link);
+}
+
+/**
+ * Inserts a link in the beginning of the list.
+ *
+ * @param head: A pointer to the list sentinel.
+ * @param link: A pointer to the link to be inserted.
+ */
+static inline void listInsertBeginning(ListLink *head, ListLink *link) {
+    listInsertAfter(head, link);
+}
+
+/**
+ * Inserts a link in the end of the list.
+ *
+ * @param head: A pointer to the list sentinel.
+ * @param link: A pointer to the link to be inserted.
+ */
+static inline void listInsertEnd(ListLink *head, ListLink *link) {
+    listInsertAfter(head->previous, link);
+}
+
+/**
+ * Unlinks a link from the list it belongs to in O(1).
+ *
+ * The link points to itself afterwards, so unlinking it
+ * again is harmless.
+ *
+ * @param link: A pointer to the link to be unlinked.
+ */
+static inline void listUnlink(ListLink *link) {
+    link->previous->next = link->next;
+    link->next->previous = link->previous;
+    link->next = link->previous = link;
+}
+
+/**
+ * Moves all links from one list to the end of another in O(1).
+ *
+ * @param head: A pointer to the receiving list sentinel.
+ * @param other: A pointer to the sentinel of the list to be
+ * moved. It is left empty.
+ */
+static inline void listSplice(ListLink *head, ListLink *other) {
+    if (listEmpty(other)) {
+        return;
+    }
+
+    other->next->previous = head->previous;
+    head->previous->next = other->next;
+    other->previous->next = head;
+    head->previous = other->previous;
+
+    listInit(other);
+}
+
+/**
+ * Iterates over the links of a list. The current link
+ * must not be unlinked inside the loop.
+ */
+#define listForEach(pos, head) \
+    for ((pos) = (head)->next; (pos) != (head); (pos) = (pos)->next)
+
+/**
+ * Iterates over the links of a list, allowing the current
+ * link to be unlinked inside the loop. tmp is used to keep
+ * the successor.
+ */
+#define listForEachSafe(pos, tmp, head) \
+    for ((pos) = (head)->next, (tmp) = (pos)->next; (pos) != (head); \
+         (pos) = (tmp), (tmp) = (pos)->next)
+
+/**
+ * Iterates over the structs of the given type that embed
+ * the links of a list in the given member.
+ */
+#define listForEachEntry(entry, head, type, member) \
+    for ((entry) = container_of((head)->next, type, member); \
+         &(entry)->member != (head); \
+         (entry) = container_of((entry)->member.next, type, member))
+
+/******************************************************
+ ***************** SINGLY LINKED LISTS ****************
+ ******************************************************/
+/**
+ * Initializes an empty list.
+ *
+ * @param head: A pointer to the list sentinel.
+ */
+static inline void sListInit(SListLink *head) {
+    head->next = NULL;
+}
+
+/**
+ * Tells whether the list has no elements.
+ *
+ * @param head: A pointer to the list sentinel.
+ * @return 1 if the list is empty, 0 otherwise.
+ */
+static inline int sListEmpty(const SListLink *head) {
+    return head->next == NULL;
+}
+
+/**
+ * Inserts a link right after another one. Passing the
+ * sentinel inserts in the beginning of the list.
+ *
+ * @param pos: A pointer to a link already in the list.
+ * @param link: A pointer to the link to be inserted.
+ */
+static inline void sListInsertAfter(SListLink *pos, SListLink *link) {
+    link->next = pos->next;
+    pos->next = link;
+}
+
+/**
+ * Unlinks the link right after another one.
+ *
+ * Singly linked links do not know their predecessors, so
+ * removal is done through the previous link.
+ *
+ * @param pos: A pointer to the predecessor of the link to
+ * be unlinked.
+ * @return the unlinked link, or NULL if pos was the last one.
+ */
+static inline SListLink *sListUnlinkAfter(SListLink *pos) {
+    SListLink *link = pos->next;
+
+    if (link) {
+        pos->next = link->next;
+        link->next = NULL;
+    }
+
+    return link;
+}
+
+/**
+ * Unlinks a link from the list, searching for its predecessor.
+ *
+ * @param head: A pointer to the list sentinel.
+ * @param link: A pointer to the link to be unlinked.
+ * @return 1 if the link was found and unlinked, 0 otherwise.
+ */
+static inline int sListUnlink(SListLink *head, SListLink *link) {
+    SListLink *p;
+
+    for (p = head; p->next; p = p->next) {
+        if (p->next == link) {
+            sListUnlinkAfter(p);
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Iterates over the links of a list. The current link
+ * must not be unlinked inside the loop.
+ */
+#define sListForEach(pos, head) \
+    for ((pos) = (head)->next; (pos); (pos) = (pos)->next)
+
+/**
+ * Iterates over the structs of the given type that embed
+ * the links of a list in the given member.
+ */
+#define sListForEachEntry(entry, head, type, member) \
+    for ((entry) = (head)->next ? container_of((head)->next, type, member) : NULL; \
+         (entry); \
+         (entry) = (entry)->member.next ? container_of((entry)->member.next, type, member) : NULL)
+
+#endif // INTRUSIVE_LINKED_LIST_H
@@ -6,19 +6,74 @@ typedef struct node {
     int info;
 } Node;
 
+typedef struct list {
+    // Defines a list header. It keeps pointers to both
+    // ends of the list and the number of nodes in it, so
+    // operations on the tail do not traverse the list.
+    Node *head, *tail;
+    int size;
+} List;
+
 #endif // NODE_H
 
+// Exported names. The doubly linked list and the binary search
+// tree have functions with the same names, so each structure gets
+// its own prefix and all of them link into the same library. Code
+// keeps using the names on the left.
+#define createNode               ads_sll_createNode
+#define freeList                 ads_sll_freeList
+#define freeListRecursive        ads_sll_freeListRecursive
+#define insertEnd                ads_sll_insertEnd
+#define insertEndRecursive       ads_sll_insertEndRecursive
+#define insertBeginning          ads_sll_insertBeginning
+#define insertAt                 ads_sll_insertAt
+#define removeNode               ads_sll_removeNode
+#define removeNodeRecursive      ads_sll_removeNodeRecursive
+#define removeFirstNode          ads_sll_removeFirstNode
+#define removeLastNode           ads_sll_removeLastNode
+#define removeLastNodeRecursive  ads_sll_removeLastNodeRecursive
+#define searchNode               ads_sll_searchNode
+#define lastNode                 ads_sll_lastNode
+#define lastNodeRecursive        ads_sll_lastNodeRecursive
+#define popLastNode              ads_sll_popLastNode
+#define popFirstNode             ads_sll_popFirstNode
+#define printList                ads_sll_printList
+#define printListRecursive       ads_sll_printListRecursive
+#define reverseList              ads_sll_reverseList
+#define reverseListRecursiveUtil ads_sll_reverseListRecursiveUtil
+#define reverseListRecursive     ads_sll_reverseListRecursive
+#define createList               ads_sll_createList
+#define clearList                ads_sll_clearList
+#define insertEndList            ads_sll_insertEndList
+#define insertBeginningList      ads_sll_insertBeginningList
+#define removeNodeList           ads_sll_removeNodeList
+#define removeFirstNodeList      ads_sll_removeFirstNodeList
+#define removeLastNodeList       ads_sll_removeLastNodeList
+#define lastNodeList             ads_sll_lastNodeList
+#define popLastNodeList          ads_sll_popLastNodeList
+#define popFirstNodeList         ads_sll_popFirstNodeList
+#define sizeList                 ads_sll_sizeList
+#define mergeSort                ads_sll_mergeSort
+#define mergeSortList            ads_sll_mergeSortList
+#define mergeSortedLists         ads_sll_mergeSortedLists
+#define dedupeSorted             ads_sll_dedupeSorted
+#define mergeSortedListsList     ads_sll_mergeSortedListsList
+#define dedupeSortedList         ads_sll_dedupeSortedList
+#define spliceLists              ads_sll_spliceLists
+
 Node *createNode(int info);
 void freeList(Node *head);
 void freeListRecursive(Node *head);
 Node *insertEnd(Node *head, Node *newNode);
 Node *insertEndRecursive(Node *head, Node *newNode);
 Node *insertBeginning(Node *head, Node *newNode);
+Node *insertAt(Node *head, Node *newNode, int pos);
 Node *removeNode(Node *head, int info);
 Node *removeNodeRecursive(Node *head, int info);
 Node *removeFirstNode(Node *head);
 Node *removeLastNode(Node *head);
 Node *removeLastNodeRecursive(Node *head);
+int searchNode(Node *head, int info);
 Node *lastNode(Node *head);
 Node *lastNodeRecursive(Node *head);
 Node *popLastNode(Node **head);
@@ -28,3 +83,21 @@ void printListRecursive(Node *head);
 Node *reverseList(Node *head);
 void reverseListRecursiveUtil(Node *head, Node *prev, Node **newHead);
 Node *reverseListRecursive(Node *head);
+void createList(List *list);
+void clearList(List *list);
+void insertEndList(List *list, Node *newNode);
+void insertBeginningList(List *list, Node *newNode);
+int removeNodeList(List *list, int info);
+void removeFirstNodeList(List *list);
+void removeLastNodeList(List *list);
+Node *lastNodeList(List *list);
+Node *popLastNodeList(List *list);
+Node *popFirstNodeList(List *list);
+int sizeList(List *list);
+Node *mergeSort(Node *head);
+void mergeSortList(List *list);
+Node *mergeSortedLists(Node *a, Node *b);
+Node *dedupeSorted(Node *head);
+void mergeSortedListsList(List *list, List *other);
+void dedupeSortedList(List *list);
+void spliceLists(List *list, List *other);
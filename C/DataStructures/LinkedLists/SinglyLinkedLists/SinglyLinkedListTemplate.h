@@ -0,0 +1,243 @@
+#ifndef SINGLY_LINKED_LIST_TEMPLATE_H
+#define SINGLY_LINKED_LIST_TEMPLATE_H
+
+#include <stdlib.h>
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Singly linked lists of any type, with a header keeping both
+// ends and the size. DEFINE_LIST(T) generates the types Node_T
+// and List_T and the functions of the list header of the int
+// list (SinglyLinkedList.h), named as them followed by _T.
+// They are static inline, so each instantiation is compiled
+// and inlined for its own type where it is used. The int list
+// in libads stays the default.
+//
+// T must be a single identifier, so types such as unsigned
+// long or structs need a typedef first. Functions searching
+// by value are generated apart, by DEFINE_LIST_SEARCH(T, equal),
+// since records need their own equality. equal(a, b) may be a
+// macro or a function, and ADS_EQUAL compares with ==.
+//
+// Example:
+//
+//     typedef long long llong;
+//
+//     DEFINE_LIST(llong)
+//     DEFINE_LIST_SEARCH(llong, ADS_EQUAL)
+//
+//     List_llong list;
+//     Node_llong *p;
+//
+//     createList_llong(&list);
+//     insertEndList_llong(&list, createNode_llong(1LL << 40));
+//     for (p = list.head; p; p = p->next) {
+//         printf("%lld\n", p->info);
+//     }
+//     clearList_llong(&list);
+
+#ifndef ADS_EQUAL
+#define ADS_EQUAL(a, b) ((a) == (b))
+#endif
+
+/******************************************************
+ ***************** TEMPLATE ***************************
+ ******************************************************/
+#define DEFINE_LIST(T)                                                          \
+typedef struct node_##T {                                                       \
+    struct node_##T *next;                                                      \
+    T info;                                                                     \
+} Node_##T;                                                                     \
+                                                                                \
+typedef struct {                                                                \
+    Node_##T *head, *tail;                                                      \
+    int size;                                                                   \
+} List_##T;                                                                     \
+                                                                                \
+/* Creates a node holding info, or returns NULL if there */                     \
+/* is no memory. */                                                             \
+static inline Node_##T *createNode_##T(T info) {                                \
+    Node_##T *newNode = (Node_##T *) malloc(sizeof(Node_##T));                  \
+                                                                                \
+    if (newNode) {                                                              \
+        newNode->next = NULL;                                                   \
+        newNode->info = info;                                                   \
+    }                                                                           \
+                                                                                \
+    return newNode;                                                             \
+}                                                                               \
+                                                                                \
+/* Initializes an empty list header. */                                         \
+static inline void createList_##T(List_##T *list) {                             \
+    if (list) {                                                                 \
+        list->head = list->tail = NULL;                                         \
+        list->size = 0;                                                         \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+/* Frees all nodes and empties the list header. */                              \
+static inline void clearList_##T(List_##T *list) {                              \
+    Node_##T *p, *next;                                                         \
+                                                                                \
+    if (list) {                                                                 \
+        for (p = list->head; p; p = next) {                                     \
+            next = p->next;                                                     \
+            free(p);                                                            \
+        }                                                                       \
+        createList_##T(list);                                                   \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+/* Inserts a node in the end of the list in O(1). */                            \
+static inline void insertEndList_##T(List_##T *list, Node_##T *newNode) {       \
+    newNode->next = NULL;                                                       \
+                                                                                \
+    if (list->tail) {                                                           \
+        list->tail->next = newNode;                                             \
+    }                                                                           \
+    else {                                                                      \
+        list->head = newNode;                                                   \
+    }                                                                           \
+                                                                                \
+    list->tail = newNode;                                                       \
+    list->size++;                                                               \
+}                                                                               \
+                                                                                \
+/* Inserts a node in the beginning of the list. */                              \
+static inline void insertBeginningList_##T(List_##T *list, Node_##T *newNode) { \
+    newNode->next = list->head;                                                 \
+    list->head = newNode;                                                       \
+                                                                                \
+    if (!list->tail) {                                                          \
+        list->tail = newNode;                                                   \
+    }                                                                           \
+                                                                                \
+    list->size++;                                                               \
+}                                                                               \
+                                                                                \
+/* Returns the first node and removes it from the list, or */                   \
+/* returns NULL if the list is empty. */                                        \
+static inline Node_##T *popFirstNodeList_##T(List_##T *list) {                  \
+    Node_##T *p = list->head;                                                   \
+                                                                                \
+    if (p) {                                                                    \
+        list->head = p->next;                                                   \
+        if (!list->head) {                                                      \
+            list->tail = NULL;                                                  \
+        }                                                                       \
+                                                                                \
+        p->next = NULL;                                                         \
+        list->size--;                                                           \
+    }                                                                           \
+                                                                                \
+    return p;                                                                   \
+}                                                                               \
+                                                                                \
+/* Returns the last node and removes it from the list, or */                    \
+/* returns NULL if the list is empty. Nodes do not know their */                \
+/* predecessors, so the list is traversed to find the new tail. */              \
+static inline Node_##T *popLastNodeList_##T(List_##T *list) {                   \
+    Node_##T *p, *last = list->tail;                                            \
+                                                                                \
+    if (!last) {                                                                \
+        return NULL;                                                            \
+    }                                                                           \
+                                                                                \
+    if (list->head == last) {                                                   \
+        list->head = list->tail = NULL;                                         \
+    }                                                                           \
+    else {                                                                      \
+        for (p = list->head; p->next != last; p = p->next);                     \
+                                                                                \
+        p->next = NULL;                                                         \
+        list->tail = p;                                                         \
+    }                                                                           \
+                                                                                \
+    list->size--;                                                               \
+                                                                                \
+    return last;                                                                \
+}                                                                               \
+                                                                                \
+/* Removes and frees the first node of the list. */                             \
+static inline void removeFirstNodeList_##T(List_##T *list) {                    \
+    free(popFirstNodeList_##T(list));                                           \
+}                                                                               \
+                                                                                \
+/* Removes and frees the last node of the list. */                              \
+static inline void removeLastNodeList_##T(List_##T *list) {                     \
+    free(popLastNodeList_##T(list));                                            \
+}                                                                               \
+                                                                                \
+/* Returns the last node of the list in O(1). */                                \
+static inline Node_##T *lastNodeList_##T(List_##T *list) {                      \
+    return list->tail;                                                          \
+}                                                                               \
+                                                                                \
+/* Returns the number of nodes in the list in O(1). */                          \
+static inline int sizeList_##T(List_##T *list) {                                \
+    return list->size;                                                          \
+}                                                                               \
+                                                                                \
+/* Moves all nodes of other to the end of list in O(1), */                      \
+/* leaving other empty. */                                                      \
+static inline void spliceLists_##T(List_##T *list, List_##T *other) {           \
+    if (!other->head) {                                                         \
+        return;                                                                 \
+    }                                                                           \
+                                                                                \
+    if (list->tail) {                                                           \
+        list->tail->next = other->head;                                         \
+    }                                                                           \
+    else {                                                                      \
+        list->head = other->head;                                               \
+    }                                                                           \
+                                                                                \
+    list->tail = other->tail;                                                   \
+    list->size += other->size;                                                  \
+    createList_##T(other);                                                      \
+}
+
+#define DEFINE_LIST_SEARCH(T, equal)                                            \
+/* Returns the first node holding a value equal to info, or */                  \
+/* NULL if there is none. */                                                    \
+static inline Node_##T *findNodeList_##T(List_##T *list, T info) {              \
+    Node_##T *p;                                                                \
+                                                                                \
+    for (p = list->head; p && !equal(p->info, info); p = p->next);              \
+                                                                                \
+    return p;                                                                   \
+}                                                                               \
+                                                                                \
+/* Removes and frees the first node holding a value equal to */                 \
+/* info. Returns 1 if a node was removed, 0 otherwise. */                       \
+static inline int removeNodeList_##T(List_##T *list, T info) {                  \
+    Node_##T *p1 = NULL, *p2 = list->head;                                      \
+                                                                                \
+    while (p2 && !equal(p2->info, info)) {                                      \
+        p1 = p2;                                                                \
+        p2 = p2->next;                                                          \
+    }                                                                           \
+                                                                                \
+    if (!p2) {                                                                  \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    if (p1) {                                                                   \
+        p1->next = p2->next;                                                    \
+    }                                                                           \
+    else {                                                                      \
+        list->head = p2->next;                                                  \
+    }                                                                           \
+                                                                                \
+    if (list->tail == p2) {                                                     \
+        list->tail = p1;                                                        \
+    }                                                                           \
+                                                                                \
+    list->size--;                                                               \
+    free(p2);                                                                   \
+                                                                                \
+    return 1;                                                                   \
+}
+
+#endif // SINGLY_LINKED_LIST_TEMPLATE_H
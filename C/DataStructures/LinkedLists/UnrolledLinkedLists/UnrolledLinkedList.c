@@ -0,0 +1,451 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "UnrolledLinkedList.h"
+
+/******************************************************
+ ***************** MEMORY MANAGEMENT ******************
+ ******************************************************/
+ /**
+ * Creates a new, empty, list node.
+ *
+ * It allocates space in the memory and initializes the
+ * fields with a NULL pointer to the successor and no
+ * elements stored.
+ *
+ * @return a pointer to the new node or NULL if memory
+ * could not be allocated.
+ */
+UnrolledNode *createUnrolledNode() {
+    UnrolledNode *newNode = (UnrolledNode *) malloc(sizeof(UnrolledNode));
+
+    if (newNode) {
+        newNode->next = NULL;
+        newNode->n = 0;
+    }
+
+    return newNode;
+}
+
+/**
+ * Frees the memory used by list nodes.
+ *
+ * @param head: A pointer to the list head.
+ */
+void freeUnrolledList(UnrolledNode *head) {
+    UnrolledNode *p;
+
+    while (head) {
+        p = head;
+        head = head->next;
+        free(p);
+        p = NULL;
+    }
+}
+
+/******************************************************
+ ***************** BASIC OPERATIONS *******************
+ ******************************************************/
+/**
+ * Inserts a new element in the end of the list.
+ *
+ * If the last node is full, a new node is appended instead
+ * of splitting it, so lists built by successive insertions
+ * in the end have all of their nodes but the last one full.
+ *
+ * @param head: A double pointer to the list head.
+ * @param info: The value to be inserted.
+ * @return 1 if successful, 0 if memory could not be allocated.
+ */
+int insertUnrolledEnd(UnrolledNode **head, int info) {
+    UnrolledNode *p;
+
+    if (!head) {
+        return 0;
+    }
+
+    // If the list is empty, creates its first node.
+    if (!*head) {
+        *head = createUnrolledNode();
+
+        if (!*head) {
+            return 0;
+        }
+    }
+
+    // Traverses the list searching for its end.
+    p = *head;
+    while (p->next) {
+        p = p->next;
+    }
+
+    // Appends a new node if the last one can't fit more elements.
+    if (p->n == UNROLLED_NODE_CAPACITY) {
+        p->next = createUnrolledNode();
+
+        if (!p->next) {
+            return 0;
+        }
+
+        p = p->next;
+    }
+
+    p->info[p->n] = info;
+    p->n++;
+
+    return 1;
+}
+
+/**
+ * Inserts a new element in the beginning of the list.
+ *
+ * @param head: A double pointer to the list head.
+ * @param info: The value to be inserted.
+ * @return 1 if successful, 0 if memory could not be allocated.
+ */
+int insertUnrolledBeginning(UnrolledNode **head, int info) {
+    return insertUnrolledAt(head, info, 0);
+}
+
+/**
+ * Inserts a new element in a specific position of the list.
+ *
+ * The position can be anything in the range between 0 and the
+ * number of elements in the list. It jumps a whole node per
+ * iteration while searching for the position. If the node where
+ * the element belongs is full, it is split in two halves first.
+ *
+ * @param head: A double pointer to the list head.
+ * @param info: The value to be inserted.
+ * @param pos: The position to insert the new value.
+ * @return 1 if successful, 0 if the position is out of bounds or
+ * memory could not be allocated.
+ */
+int insertUnrolledAt(UnrolledNode **head, int info, int pos) {
+    UnrolledNode *p;
+
+    if (!head || pos < 0) {
+        return 0;
+    }
+
+    // If the list is empty, creates its first node.
+    if (!*head) {
+        if (pos > 0) {
+            return 0;
+        }
+
+        *head = createUnrolledNode();
+
+        if (!*head) {
+            return 0;
+        }
+    }
+
+    // Searches for the node containing the position. A position
+    // in the boundary of two nodes belongs to the first one.
+    p = *head;
+    while (pos > p->n && p->next) {
+        pos -= p->n;
+        p = p->next;
+    }
+
+    if (pos > p->n) {
+        return 0;
+    }
+
+    // Splits the node if it can't fit more elements.
+    if (p->n == UNROLLED_NODE_CAPACITY) {
+        if (!splitUnrolledNode(p)) {
+            return 0;
+        }
+
+        if (pos > p->n) {
+            pos -= p->n;
+            p = p->next;
+        }
+    }
+
+    // Moves to the right all elements from pos on.
+    memmove(&p->info[pos+1], &p->info[pos], sizeof(int) * (p->n - pos));
+
+    p->info[pos] = info;
+    p->n++;
+
+    return 1;
+}
+
+/**
+ * Effectively removes the i-th element of a node.
+ *
+ * If the node becomes less than half full, it is rebalanced
+ * with its successor. Nodes left empty are unlinked and freed.
+ *
+ * @param head: A double pointer to the list head.
+ * @param prev: A pointer to the node predecessor, NULL if it
+ * is the head.
+ * @param p: A pointer to the node holding the element.
+ * @param i: The index of the element inside the node.
+ */
+static void removeFromNode(UnrolledNode **head, UnrolledNode *prev, UnrolledNode *p, int i) {
+    // Moves to the left all elements after the one to be removed.
+    memmove(&p->info[i], &p->info[i+1], sizeof(int) * (p->n - i - 1));
+    p->n--;
+
+    if (p->n < UNROLLED_NODE_CAPACITY / 2) {
+        mergeUnrolledNodes(p);
+    }
+
+    // Unlinks the node if nothing could be borrowed from the successor.
+    if (p->n == 0) {
+        if (prev) {
+            prev->next = p->next;
+        }
+        else {
+            *head = p->next;
+        }
+
+        free(p);
+        p = NULL;
+    }
+}
+
+/**
+ * Removes an element from the list, according to its value.
+ *
+ * It searches for the first occurrence of the element and deletes
+ * it. If there is no occurrence, returns the list as-is.
+ *
+ * @param head: A double pointer to the list head.
+ * @param info: The value to be removed.
+ * @return 1 if the element was found and removed, 0 otherwise.
+ */
+int removeUnrolled(UnrolledNode **head, int info) {
+    UnrolledNode *p, *prev;
+    int i;
+
+    if (!head) {
+        return 0;
+    }
+
+    // Searches for the provided value, one node at a time.
+    prev = NULL;
+    for (p = *head; p; p = p->next) {
+        for (i = 0; i < p->n; i++) {
+            if (p->info[i] == info) {
+                removeFromNode(head, prev, p, i);
+
+                return 1;
+            }
+        }
+
+        prev = p;
+    }
+
+    return 0;
+}
+
+/**
+ * Removes the element in a specific position of the list.
+ *
+ * @param head: A double pointer to the list head.
+ * @param pos: The position where to remove the value.
+ * @return 1 if successful, 0 if the position is out of bounds.
+ */
+int removeUnrolledAt(UnrolledNode **head, int pos) {
+    UnrolledNode *p, *prev;
+
+    if (!head || pos < 0) {
+        return 0;
+    }
+
+    // Searches for the node containing the position.
+    prev = NULL;
+    p = *head;
+    while (p && pos >= p->n) {
+        pos -= p->n;
+        prev = p;
+        p = p->next;
+    }
+
+    if (!p) {
+        return 0;
+    }
+
+    removeFromNode(head, prev, p, pos);
+
+    return 1;
+}
+
+/**
+ * Searches for an element in the list.
+ *
+ * @param head: A pointer to the list head.
+ * @param info: The value to be searched.
+ * @return the position of the first occurrence of the
+ * value, or -1 if it is not in the list.
+ */
+int searchUnrolled(UnrolledNode *head, int info) {
+    UnrolledNode *p;
+    int i, offset;
+
+    offset = 0;
+    for (p = head; p; p = p->next) {
+        for (i = 0; i < p->n; i++) {
+            if (p->info[i] == info) {
+                return offset + i;
+            }
+        }
+
+        offset += p->n;
+    }
+
+    return -1;
+}
+
+/**
+ * Gets the last element of the list.
+ *
+ * Its value is stored in the pointer received by parameter.
+ * If the list is empty, last is not changed.
+ *
+ * @param head: A pointer to the list head.
+ * @param last: A pointer to store the last element value.
+ * @return 1 if successful, 0 if the list is empty.
+ */
+int lastUnrolled(UnrolledNode *head, int *last) {
+    if (!head) {
+        return 0;
+    }
+
+    while (head->next) {
+        head = head->next;
+    }
+
+    if (head->n == 0) {
+        return 0;
+    }
+
+    *last = head->info[head->n-1];
+
+    return 1;
+}
+
+/**
+ * Counts the elements stored in the list.
+ *
+ * @param head: A pointer to the list head.
+ * @return the number of elements.
+ */
+int sizeUnrolled(UnrolledNode *head) {
+    int n = 0;
+
+    for (; head; head = head->next) {
+        n += head->n;
+    }
+
+    return n;
+}
+
+/******************************************************
+ ***************** ADVANCED OPERATIONS ****************
+ ******************************************************/
+/**
+ * Splits a node in two.
+ *
+ * It creates a new node right after the given one and moves
+ * to it the upper half of the elements.
+ *
+ * @param node: A pointer to the node to be split.
+ * @return 1 if successful, 0 if memory could not be allocated.
+ */
+int splitUnrolledNode(UnrolledNode *node) {
+    UnrolledNode *newNode;
+    int half;
+
+    if (!node) {
+        return 0;
+    }
+
+    newNode = createUnrolledNode();
+
+    if (!newNode) {
+        return 0;
+    }
+
+    half = node->n / 2;
+
+    memcpy(newNode->info, &node->info[half], sizeof(int) * (node->n - half));
+    newNode->n = node->n - half;
+    node->n = half;
+
+    newNode->next = node->next;
+    node->next = newNode;
+
+    return 1;
+}
+
+/**
+ * Rebalances a node with its successor.
+ *
+ * If the elements of both fit in a single node, the successor
+ * is merged into the given node and freed. Otherwise, elements
+ * are borrowed from the successor until the node is half full.
+ *
+ * @param node: A pointer to the node to be rebalanced.
+ */
+void mergeUnrolledNodes(UnrolledNode *node) {
+    UnrolledNode *succ;
+    int moved;
+
+    if (!node || !node->next) {
+        return;
+    }
+
+    succ = node->next;
+
+    if (node->n + succ->n <= UNROLLED_NODE_CAPACITY) {
+        memcpy(&node->info[node->n], succ->info, sizeof(int) * succ->n);
+        node->n += succ->n;
+        node->next = succ->next;
+
+        free(succ);
+        succ = NULL;
+
+        return;
+    }
+
+    moved = UNROLLED_NODE_CAPACITY / 2 - node->n;
+
+    if (moved > 0) {
+        memcpy(&node->info[node->n], succ->info, sizeof(int) * moved);
+        memmove(succ->info, &succ->info[moved], sizeof(int) * (succ->n - moved));
+        node->n += moved;
+        succ->n -= moved;
+    }
+}
+
+/******************************************************
+ ***************** OUTPUT *****************************
+ ******************************************************/
+/**
+ * Prints a representation of the list.
+ *
+ * Each node is represented by its elements between brackets.
+ * It uses the -> symbols to represent the link between two
+ * nodes. Null nodes are represented with -.
+ *
+ * @param head: A pointer to the list head.
+ */
+void printUnrolledList(UnrolledNode *head) {
+    UnrolledNode *p;
+    int i;
+
+    for (p = head; p; p = p->next) {
+        printf("[");
+        for (i = 0; i < p->n; i++) {
+            printf(i > 0 ? " %d" : "%d", p->info[i]);
+        }
+        printf("] -> ");
+    }
+    printf("-\n");
+}
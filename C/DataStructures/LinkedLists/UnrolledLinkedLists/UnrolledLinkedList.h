@@ -0,0 +1,49 @@
+#ifndef UNROLLED_NODE_H
+#define UNROLLED_NODE_H
+
+// Maximum number of ints stored by each node. The default
+// makes a node (pointer + counter + elements) fill exactly
+// one 64-byte cache line on 64-bit platforms.
+#ifndef UNROLLED_NODE_CAPACITY
+#define UNROLLED_NODE_CAPACITY 13
+#endif
+
+typedef struct unrolledNode {
+    // Defines a node holding a block of ints. n will
+    // store the number of elements in use in the info
+    // array, which are always kept contiguous from 0.
+    struct unrolledNode *next;
+    int n;
+    int info[UNROLLED_NODE_CAPACITY];
+} UnrolledNode;
+
+// Exported names.
+#define createUnrolledNode      ads_unrolled_createUnrolledNode
+#define freeUnrolledList        ads_unrolled_freeUnrolledList
+#define insertUnrolledEnd       ads_unrolled_insertUnrolledEnd
+#define insertUnrolledBeginning ads_unrolled_insertUnrolledBeginning
+#define insertUnrolledAt        ads_unrolled_insertUnrolledAt
+#define removeUnrolled          ads_unrolled_removeUnrolled
+#define removeUnrolledAt        ads_unrolled_removeUnrolledAt
+#define searchUnrolled          ads_unrolled_searchUnrolled
+#define lastUnrolled            ads_unrolled_lastUnrolled
+#define sizeUnrolled            ads_unrolled_sizeUnrolled
+#define splitUnrolledNode       ads_unrolled_splitUnrolledNode
+#define mergeUnrolledNodes      ads_unrolled_mergeUnrolledNodes
+#define printUnrolledList       ads_unrolled_printUnrolledList
+
+UnrolledNode *createUnrolledNode();
+void freeUnrolledList(UnrolledNode *head);
+int insertUnrolledEnd(UnrolledNode **head, int info);
+int insertUnrolledBeginning(UnrolledNode **head, int info);
+int insertUnrolledAt(UnrolledNode **head, int info, int pos);
+int removeUnrolled(UnrolledNode **head, int info);
+int removeUnrolledAt(UnrolledNode **head, int pos);
+int searchUnrolled(UnrolledNode *head, int info);
+int lastUnrolled(UnrolledNode *head, int *last);
+int sizeUnrolled(UnrolledNode *head);
+int splitUnrolledNode(UnrolledNode *node);
+void mergeUnrolledNodes(UnrolledNode *node);
+void printUnrolledList(UnrolledNode *head);
+
+#endif // UNROLLED_NODE_H
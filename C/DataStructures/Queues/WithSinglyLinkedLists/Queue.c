@@ -16,7 +16,8 @@
  */
 void createQueue(Queue *q) {
     if (q) {
-        q->data = q->front = q->rear = NULL;
+        createList(&(q->data));
+        q->front = q->rear = NULL;
     }
 }
 
@@ -26,7 +27,8 @@ void createQueue(Queue *q) {
  * @param q: A pointer to the queue.
  */
 void freeQueue(Queue *q) {
-    freeList(q->data);
+    clearList(&(q->data));
+    q->front = q->rear = NULL;
 }
 
 /******************************************************
@@ -36,7 +38,7 @@ void freeQueue(Queue *q) {
  * Enqueues a new element.
  *
  * It takes a new element to be queued, stores it in a Node
- * and inserts it in the beginning of the data linked list.
+ * and inserts it in the end of the data linked list, in O(1).
  * It positions the rear pointer to the new element. If it is
  * the first element in the queue, also positions the front
  * pointer.
@@ -49,16 +51,13 @@ int enqueue(Queue *q, int info) {
     Node *newNode = createNode(info);
 
     if (newNode) {
-        // Insert new node in the beginning of the queue.
-        q->data = insertBeginning(q->data, newNode);
+        // Inserts new node in the end of the queue.
+        insertEndList(&(q->data), newNode);
 
-        // Updates rear to the new element.
-        q->rear = q->data;
-
-        // Special case: first insertion.
-        if (!q->front) {
-            q->front = q->data;
-        }
+        // Updates rear to the new element, and front on the
+        // first insertion.
+        q->rear = q->data.tail;
+        q->front = q->data.head;
 
         return 1;
     }
@@ -70,7 +69,8 @@ int enqueue(Queue *q, int info) {
  * Dequeues the first element.
  *
  * It removes the front element from the queue and returns
- * it. It also appropriately updates the rear and front pointers.
+ * it, in O(1). It also appropriately updates the rear and front
+ * pointers.
  *
  * @param q: A pointer to the queue.
  * @return the front node.
@@ -82,11 +82,12 @@ Node *dequeue(Queue *q) {
         return NULL;
     }
 
-    // Dequeues last node in the linked list (the queue front node).
-    front = popLastNode(&(q->data));
+    // Dequeues first node in the linked list (the queue front node).
+    front = popFirstNodeList(&(q->data));
 
-    // Adjusts front pointer.
-    q->front = lastNode(q->data);
+    // Adjusts front and rear pointers.
+    q->front = q->data.head;
+    q->rear = q->data.tail;
 
     return front;
 }
@@ -98,10 +99,10 @@ Node *dequeue(Queue *q) {
  * Prints a representation of the queue.
  *
  * It uses the -> symbols to represent the precedence of
- * two nodes.
+ * two nodes, from the front to the rear.
  *
  * @param q: The queue.
  */
 void printQueue(Queue q) {
-    printList(q.data);
+    printList(q.data.head);
 }
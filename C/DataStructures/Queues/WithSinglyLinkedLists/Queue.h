@@ -1,12 +1,26 @@
+#ifndef QUEUE_H
+#define QUEUE_H
+
 #include "../../LinkedLists/SinglyLinkedLists/SinglyLinkedList.h"
 
 typedef struct {
-    Node *data;
+    // Defines a queue. data holds its elements from the
+    // front to the rear, so both ends are reached in O(1).
+    List data;
     Node *rear, *front;
 } Queue;
 
+// Exported names.
+#define createQueue ads_queue_createQueue
+#define freeQueue   ads_queue_freeQueue
+#define enqueue     ads_queue_enqueue
+#define dequeue     ads_queue_dequeue
+#define printQueue  ads_queue_printQueue
+
 void createQueue(Queue *q);
 void freeQueue(Queue *q);
 int enqueue(Queue *q, int info);
 Node *dequeue(Queue *q);
 void printQueue(Queue q);
+
+#endif // QUEUE_H
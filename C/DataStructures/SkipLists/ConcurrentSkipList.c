@@ -0,0 +1,386 @@
+#include <stdlib.h>
+#include "ConcurrentSkipList.h"
+
+// Lowest bit of a successor pointer, set when its node is
+// being removed from that level.
+#define MARK ((uintptr_t) 1)
+
+/******************************************************
+ ***************** AUXILIARY FUNCTIONS ****************
+ ******************************************************/
+/**
+ * Returns the node a successor pointer points to, without
+ * the mark.
+ */
+static inline ConcurrentSkipNode *unmarked(uintptr_t link) {
+    return (ConcurrentSkipNode *) (link & ~MARK);
+}
+
+/**
+ * Reads the successor of a node in a level.
+ */
+static inline uintptr_t loadNext(ConcurrentSkipNode *node, int level) {
+    return atomic_load_explicit(&node->next[level], memory_order_acquire);
+}
+
+/**
+ * Changes a successor pointer from expected to desired, if
+ * no other thread changed it before.
+ *
+ * @return 1 if it was changed, 0 otherwise.
+ */
+static inline int swapNext(ConcurrentSkipNode *node, int level, uintptr_t expected, uintptr_t desired) {
+    return atomic_compare_exchange_strong_explicit(&node->next[level], &expected, desired,
+        memory_order_acq_rel, memory_order_acquire);
+}
+
+/******************************************************
+ ***************** MEMORY MANAGEMENT ******************
+ ******************************************************/
+/**
+ * Creates a new concurrent skip list node.
+ *
+ * @param info: The int info stored by the node.
+ * @param level: The number of levels the node is in.
+ * @return a pointer to the new node or NULL if memory
+ * could not be allocated.
+ */
+static ConcurrentSkipNode *createConcurrentSkipNode(int info, int level) {
+    ConcurrentSkipNode *newNode = (ConcurrentSkipNode *) malloc(sizeof(ConcurrentSkipNode)
+        + sizeof(_Atomic uintptr_t) * level);
+    int i;
+
+    if (newNode) {
+        newNode->info = info;
+        newNode->level = level;
+        newNode->retired = NULL;
+        for (i = 0; i < level; i++) {
+            atomic_init(&newNode->next[i], 0);
+        }
+    }
+
+    return newNode;
+}
+
+/**
+ * Creates an empty concurrent skip list. It must be created
+ * before other threads use it.
+ *
+ * @param list: A pointer to the list to be initialized.
+ * @param seed: The seed of the generator of node levels.
+ * @return 1 if successful, 0 if memory could not be allocated.
+ */
+int createConcurrentSkipList(ConcurrentSkipList *list, uint64_t seed) {
+    if (!list || !(list->head = createConcurrentSkipNode(0, SKIP_LIST_MAX_LEVEL))) {
+        return 0;
+    }
+
+    list->seed = seed;
+    atomic_init(&list->inserts, 0);
+    atomic_init(&list->retired, NULL);
+
+    return 1;
+}
+
+/**
+ * Frees the memory used by the list nodes, including the
+ * removed ones. No other thread may be using the list.
+ *
+ * @param list: A pointer to the list.
+ */
+void freeConcurrentSkipList(ConcurrentSkipList *list) {
+    ConcurrentSkipNode *p, *next;
+    uintptr_t link;
+
+    if (!list || !list->head) {
+        return;
+    }
+
+    // Nodes still in level 0 and not marked. Marked ones are
+    // also among the removed ones.
+    for (p = unmarked(loadNext(list->head, 0)); p; p = next) {
+        link = loadNext(p, 0);
+        next = unmarked(link);
+        if (!(link & MARK)) {
+            free(p);
+        }
+    }
+
+    for (p = atomic_load(&list->retired); p; p = next) {
+        next = p->retired;
+        free(p);
+    }
+
+    free(list->head);
+    list->head = NULL;
+}
+
+/**
+ * Adds a removed node to the ones freed with the list.
+ *
+ * @param list: A pointer to the list.
+ * @param node: A pointer to the node.
+ */
+static void retireNode(ConcurrentSkipList *list, ConcurrentSkipNode *node) {
+    ConcurrentSkipNode *top = atomic_load_explicit(&list->retired, memory_order_relaxed);
+
+    do {
+        node->retired = top;
+    } while (!atomic_compare_exchange_weak_explicit(&list->retired, &top, node,
+        memory_order_release, memory_order_relaxed));
+}
+
+/******************************************************
+ ***************** BASIC OPERATIONS *******************
+ ******************************************************/
+/**
+ * Finds the last node before a key in each level, and the
+ * node after it, unlinking the marked nodes on the way.
+ *
+ * When unlinking fails, another thread changed the node
+ * before, so the search starts over from the head.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The key.
+ * @param preds: A pointer to store the node before the key
+ * in each level.
+ * @param succs: A pointer to store the node after it in each
+ * level, the least one with a key not lesser than info, or
+ * NULL.
+ * @return 1 if the key is in the list, 0 otherwise.
+ */
+static int findNodes(ConcurrentSkipList *list, int info,
+        ConcurrentSkipNode **preds, ConcurrentSkipNode **succs) {
+    ConcurrentSkipNode *pred, *curr;
+    uintptr_t succ;
+    int i;
+
+retry:
+    pred = list->head;
+    for (i = SKIP_LIST_MAX_LEVEL - 1; i >= 0; i--) {
+        curr = unmarked(loadNext(pred, i));
+
+        while (curr) {
+            succ = loadNext(curr, i);
+
+            // Unlinks curr while it is marked.
+            while (succ & MARK) {
+                if (!swapNext(pred, i, (uintptr_t) curr, succ & ~MARK)) {
+                    goto retry;
+                }
+
+                curr = unmarked(succ);
+                if (!curr) {
+                    break;
+                }
+                succ = loadNext(curr, i);
+            }
+
+            if (!curr || curr->info >= info) {
+                break;
+            }
+
+            pred = curr;
+            curr = unmarked(succ);
+        }
+
+        preds[i] = pred;
+        succs[i] = curr;
+    }
+
+    return succs[0] && succs[0]->info == info;
+}
+
+/**
+ * Inserts a key in the list.
+ *
+ * The node is linked in level 0 first, which inserts the key
+ * for all threads at once, and then in the levels above, from
+ * the bottom up. If it is removed meanwhile, it is not linked
+ * in the levels left.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The key to be inserted.
+ * @return 1 if the key was inserted, 0 if it was already in
+ * the list or memory could not be allocated.
+ */
+int insertConcurrentSkipList(ConcurrentSkipList *list, int info) {
+    ConcurrentSkipNode *preds[SKIP_LIST_MAX_LEVEL], *succs[SKIP_LIST_MAX_LEVEL];
+    ConcurrentSkipNode *newNode = NULL;
+    uintptr_t link;
+    uint64_t count;
+    int i, level = 0;
+
+    if (!list) {
+        return 0;
+    }
+
+    for (;;) {
+        if (findNodes(list, info, preds, succs)) {
+            free(newNode);
+            return 0;
+        }
+
+        if (!newNode) {
+            count = atomic_fetch_add_explicit(&list->inserts, 1, memory_order_relaxed);
+            level = skipListLevel(skipListMix(list->seed + count * 0x9e3779b97f4a7c15UL));
+            if (!(newNode = createConcurrentSkipNode(info, level))) {
+                return 0;
+            }
+        }
+
+        for (i = 0; i < level; i++) {
+            atomic_store_explicit(&newNode->next[i], (uintptr_t) succs[i], memory_order_relaxed);
+        }
+
+        if (swapNext(preds[0], 0, (uintptr_t) succs[0], (uintptr_t) newNode)) {
+            break;
+        }
+    }
+
+    for (i = 1; i < level; i++) {
+        for (;;) {
+            // Points the node to the current successor, unless it
+            // was marked by a removal.
+            link = loadNext(newNode, i);
+            if (link & MARK) {
+                return 1;
+            }
+            if (link != (uintptr_t) succs[i] && !swapNext(newNode, i, link, (uintptr_t) succs[i])) {
+                continue;
+            }
+
+            if (swapNext(preds[i], i, (uintptr_t) succs[i], (uintptr_t) newNode)) {
+                break;
+            }
+
+            // Another thread changed the level, so it is searched
+            // again, unless the node was removed in the meantime.
+            findNodes(list, info, preds, succs);
+            if (succs[0] != newNode) {
+                return 1;
+            }
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * Removes a key from the list.
+ *
+ * The node is marked from the top level down. Marking it in
+ * level 0 removes the key for all threads at once, and only
+ * one thread can do it. That thread then searches for the key
+ * again, which unlinks the node from every level.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The key to be removed.
+ * @return 1 if the key was found and removed, 0 otherwise.
+ */
+int removeConcurrentSkipList(ConcurrentSkipList *list, int info) {
+    ConcurrentSkipNode *preds[SKIP_LIST_MAX_LEVEL], *succs[SKIP_LIST_MAX_LEVEL], *p;
+    uintptr_t link;
+    int i;
+
+    if (!list || !findNodes(list, info, preds, succs)) {
+        return 0;
+    }
+    p = succs[0];
+
+    for (i = p->level - 1; i >= 1; i--) {
+        link = loadNext(p, i);
+        while (!(link & MARK) && !swapNext(p, i, link, link | MARK)) {
+            link = loadNext(p, i);
+        }
+    }
+
+    link = loadNext(p, 0);
+    for (;;) {
+        if (link & MARK) {
+            return 0; // Another thread removed it.
+        }
+        if (swapNext(p, 0, link, link | MARK)) {
+            break;
+        }
+        link = loadNext(p, 0);
+    }
+
+    findNodes(list, info, preds, succs);
+    retireNode(list, p);
+
+    return 1;
+}
+
+/**
+ * Searches for the least key not lesser than a value.
+ *
+ * It never writes to the list nor starts over: marked nodes
+ * are stepped over instead of unlinked.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The value to be searched.
+ * @return a pointer to the node of the key, or NULL if all
+ * keys are lesser.
+ */
+ConcurrentSkipNode *seekConcurrentSkipList(ConcurrentSkipList *list, int info) {
+    ConcurrentSkipNode *pred = list->head, *curr = NULL;
+    uintptr_t succ;
+    int i;
+
+    for (i = SKIP_LIST_MAX_LEVEL - 1; i >= 0; i--) {
+        curr = unmarked(loadNext(pred, i));
+
+        while (curr) {
+            succ = loadNext(curr, i);
+            while ((succ & MARK) && (curr = unmarked(succ))) {
+                succ = loadNext(curr, i);
+            }
+
+            if (!curr || curr->info >= info) {
+                break;
+            }
+
+            pred = curr;
+            curr = unmarked(succ);
+        }
+    }
+
+    return curr;
+}
+
+/**
+ * Searches for a key in the list, without locks or retries.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The key to be searched.
+ * @return 1 if the key is in the list, 0 otherwise.
+ */
+int findConcurrentSkipList(ConcurrentSkipList *list, int info) {
+    ConcurrentSkipNode *p;
+
+    if (!list) {
+        return 0;
+    }
+
+    p = seekConcurrentSkipList(list, info);
+
+    return p && p->info == info;
+}
+
+/**
+ * Returns the next node in level 0 that is not being removed,
+ * to walk the keys in ascending order.
+ *
+ * @param node: A pointer to a node.
+ * @return a pointer to the next node, or NULL at the end.
+ */
+ConcurrentSkipNode *nextConcurrentSkipNode(ConcurrentSkipNode *node) {
+    ConcurrentSkipNode *p = unmarked(loadNext(node, 0));
+
+    while (p && (loadNext(p, 0) & MARK)) {
+        p = unmarked(loadNext(p, 0));
+    }
+
+    return p;
+}
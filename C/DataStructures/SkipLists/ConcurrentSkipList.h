@@ -0,0 +1,78 @@
+#ifndef CONCURRENT_SKIP_LIST_H
+#define CONCURRENT_SKIP_LIST_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "SkipList.h"
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Concurrent skip lists are skip lists (SkipList.h) that any
+// number of threads can search and change at once, without
+// locks. Each successor pointer has a mark in its lowest bit,
+// set when its node is being removed from that level. A key is
+// removed when its node is marked in level 0, and then any
+// thread passing by unlinks the node from each level with a
+// compare-and-swap, as in the lock-free skip list of Herlihy
+// and Shavit. Searches only read: they step over marked nodes
+// and never wait or retry. Insertions and removals retry when
+// another thread changed the links they were about to change.
+//
+// Readers may still be on a node after it is removed, so
+// removed nodes are only freed with the list. Memory grows with
+// the number of removals until then.
+//
+// Walks of a range see each key that stays in the list during
+// the whole walk, and may or may not see keys inserted or
+// removed meanwhile.
+
+typedef struct concurrentSkipNode {
+    // Defines a concurrent skip list node. It is in levels
+    // 0 to level - 1, and next[i] is its successor in level
+    // i, with the mark in its lowest bit. retired links the
+    // node to the removed ones, once it is removed.
+    int info, level;
+    struct concurrentSkipNode *retired;
+    _Atomic uintptr_t next[];
+} ConcurrentSkipNode;
+
+typedef struct concurrentSkipList {
+    // Defines a concurrent skip list. head is a sentinel node
+    // in all levels. Node levels come from the seed and the
+    // count of insertions. Each field written by insertions
+    // or removals has its own cache line, so they do not slow
+    // down the searches reading head.
+    ConcurrentSkipNode *head;
+    uint64_t seed;
+    _Alignas(64) atomic_ulong inserts;
+    _Alignas(64) _Atomic(ConcurrentSkipNode *) retired;
+} ConcurrentSkipList;
+
+/**
+ * Walks the keys from low, included, to high, excluded, in
+ * ascending order.
+ */
+#define concurrentSkipListForRange(p, list, low, high) \
+    for ((p) = seekConcurrentSkipList((list), (low)); (p) && (p)->info < (high); \
+        (p) = nextConcurrentSkipNode(p))
+
+// Exported names.
+#define createConcurrentSkipList ads_cskip_createConcurrentSkipList
+#define freeConcurrentSkipList   ads_cskip_freeConcurrentSkipList
+#define insertConcurrentSkipList ads_cskip_insertConcurrentSkipList
+#define removeConcurrentSkipList ads_cskip_removeConcurrentSkipList
+#define findConcurrentSkipList   ads_cskip_findConcurrentSkipList
+#define seekConcurrentSkipList   ads_cskip_seekConcurrentSkipList
+#define nextConcurrentSkipNode   ads_cskip_nextConcurrentSkipNode
+
+int createConcurrentSkipList(ConcurrentSkipList *list, uint64_t seed);
+void freeConcurrentSkipList(ConcurrentSkipList *list);
+int insertConcurrentSkipList(ConcurrentSkipList *list, int info);
+int removeConcurrentSkipList(ConcurrentSkipList *list, int info);
+int findConcurrentSkipList(ConcurrentSkipList *list, int info);
+ConcurrentSkipNode *seekConcurrentSkipList(ConcurrentSkipList *list, int info);
+ConcurrentSkipNode *nextConcurrentSkipNode(ConcurrentSkipNode *node);
+
+#endif // CONCURRENT_SKIP_LIST_H
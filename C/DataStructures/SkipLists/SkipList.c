@@ -0,0 +1,251 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "SkipList.h"
+
+/******************************************************
+ ***************** MEMORY MANAGEMENT ******************
+ ******************************************************/
+/**
+ * Creates a new skip list node.
+ *
+ * It allocates the node with its tower of level successors,
+ * all NULL, and the info received by parameter.
+ *
+ * @param info: The int info stored by the node.
+ * @param level: The number of levels the node is in.
+ * @return a pointer to the new node or NULL if memory
+ * could not be allocated.
+ */
+static SkipNode *createSkipNode(int info, int level) {
+    SkipNode *newNode = (SkipNode *) malloc(sizeof(SkipNode) + sizeof(SkipNode *) * level);
+    int i;
+
+    if (newNode) {
+        newNode->info = info;
+        newNode->level = level;
+        for (i = 0; i < level; i++) {
+            newNode->next[i] = NULL;
+        }
+    }
+
+    return newNode;
+}
+
+/**
+ * Creates an empty skip list.
+ *
+ * @param list: A pointer to the list to be initialized.
+ * @param seed: The seed of the generator of node levels.
+ * @return 1 if successful, 0 if memory could not be allocated.
+ */
+int createSkipList(SkipList *list, uint64_t seed) {
+    if (!list || !(list->head = createSkipNode(0, SKIP_LIST_MAX_LEVEL))) {
+        return 0;
+    }
+
+    list->level = 1;
+    list->n = 0;
+    list->seed = seed;
+
+    return 1;
+}
+
+/**
+ * Frees the memory used by the list nodes.
+ *
+ * @param list: A pointer to the list.
+ */
+void freeSkipList(SkipList *list) {
+    SkipNode *p, *next;
+
+    if (list) {
+        // Every node is in level 0.
+        for (p = list->head; p; p = next) {
+            next = p->next[0];
+            free(p);
+        }
+
+        list->head = NULL;
+        list->level = list->n = 0;
+    }
+}
+
+/******************************************************
+ ***************** BASIC OPERATIONS *******************
+ ******************************************************/
+/**
+ * Finds the last node before a key in each level in use.
+ *
+ * It goes down from the top level, moving right while the
+ * next key is lesser, as a search in a singly linked list
+ * keeps a pointer to the node before the current one.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The key.
+ * @param update: A pointer to store the node found in each
+ * level.
+ * @return the node after the one found in level 0, the least
+ * one with a key not lesser than info, or NULL.
+ */
+static SkipNode *findPredecessors(const SkipList *list, int info, SkipNode **update) {
+    SkipNode *p = list->head;
+    int i;
+
+    for (i = list->level - 1; i >= 0; i--) {
+        while (p->next[i] && p->next[i]->info < info) {
+            p = p->next[i];
+        }
+        update[i] = p;
+    }
+
+    return p->next[0];
+}
+
+/**
+ * Inserts a key in the list.
+ *
+ * The node gets a random level and is linked after the
+ * predecessors of its key in each of its levels.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The key to be inserted.
+ * @return 1 if the key was inserted, 0 if it was already in
+ * the list or memory could not be allocated.
+ */
+int insertSkipList(SkipList *list, int info) {
+    SkipNode *update[SKIP_LIST_MAX_LEVEL], *p, *newNode;
+    int i, level;
+
+    if (!list) {
+        return 0;
+    }
+
+    p = findPredecessors(list, info, update);
+    if (p && p->info == info) {
+        return 0;
+    }
+
+    list->seed += 0x9e3779b97f4a7c15UL;
+    level = skipListLevel(skipListMix(list->seed));
+    if (!(newNode = createSkipNode(info, level))) {
+        return 0;
+    }
+
+    // Levels above the ones in use start at the head.
+    for (i = list->level; i < level; i++) {
+        update[i] = list->head;
+    }
+    if (level > list->level) {
+        list->level = level;
+    }
+
+    for (i = 0; i < level; i++) {
+        newNode->next[i] = update[i]->next[i];
+        update[i]->next[i] = newNode;
+    }
+    list->n++;
+
+    return 1;
+}
+
+/**
+ * Removes a key from the list, freeing its node.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The key to be removed.
+ * @return 1 if the key was found and removed, 0 otherwise.
+ */
+int removeSkipList(SkipList *list, int info) {
+    SkipNode *update[SKIP_LIST_MAX_LEVEL], *p;
+    int i;
+
+    if (!list) {
+        return 0;
+    }
+
+    p = findPredecessors(list, info, update);
+    if (!p || p->info != info) {
+        return 0;
+    }
+
+    for (i = 0; i < p->level; i++) {
+        update[i]->next[i] = p->next[i];
+    }
+    free(p);
+
+    // Levels left empty are not used anymore.
+    while (list->level > 1 && !list->head->next[list->level - 1]) {
+        list->level--;
+    }
+    list->n--;
+
+    return 1;
+}
+
+/**
+ * Searches for the least key not lesser than a value.
+ *
+ * Keys from there on are read by following next[0], which
+ * is what skipListForRange does.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The value to be searched.
+ * @return a pointer to the node of the key, or NULL if all
+ * keys are lesser.
+ */
+SkipNode *seekSkipList(const SkipList *list, int info) {
+    SkipNode *p = list->head;
+    int i;
+
+    for (i = list->level - 1; i >= 0; i--) {
+        while (p->next[i] && p->next[i]->info < info) {
+            p = p->next[i];
+        }
+    }
+
+    return p->next[0];
+}
+
+/**
+ * Searches for a key in the list.
+ *
+ * @param list: A pointer to the list.
+ * @param info: The key to be searched.
+ * @return 1 if the key is in the list, 0 otherwise.
+ */
+int findSkipList(const SkipList *list, int info) {
+    SkipNode *p;
+
+    if (!list) {
+        return 0;
+    }
+
+    p = seekSkipList(list, info);
+
+    return p && p->info == info;
+}
+
+/******************************************************
+ ***************** OUTPUT *****************************
+ ******************************************************/
+/**
+ * Prints a representation of the list.
+ *
+ * It prints each level in a line, from the top one, using
+ * the -> symbols to represent the link between two nodes.
+ * Null nodes are represented with -.
+ *
+ * @param list: A pointer to the list.
+ */
+void printSkipList(const SkipList *list) {
+    SkipNode *p;
+    int i;
+
+    for (i = list->level - 1; i >= 0; i--) {
+        printf("%2d: ", i);
+        for (p = list->head->next[i]; p; p = p->next[i]) {
+            printf("%d -> ", p->info);
+        }
+        printf("-\n");
+    }
+}
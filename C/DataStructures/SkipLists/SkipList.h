@@ -0,0 +1,82 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <stdint.h>
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Skip lists keep an ordered set of ints in sorted singly
+// linked lists, one per level. All keys are in level 0, and
+// each key in a level is also in the next one with a
+// probability of 1/4, so searches go down from the top level,
+// skipping about 3/4 of the nodes of each level, in O(log n)
+// expected time, with no rebalancing.
+//
+// Node levels come from a generator with a fixed seed, so the
+// same operations build the same list on every run.
+
+// Most levels of a node, which fits about 4^16 keys.
+#define SKIP_LIST_MAX_LEVEL 16
+
+typedef struct skipNode {
+    // Defines a skip list node. It is in levels 0 to
+    // level - 1, and next[i] is its successor in level i.
+    // The tower of successors is allocated with the node.
+    int info, level;
+    struct skipNode *next[];
+} SkipNode;
+
+typedef struct skipList {
+    // Defines a skip list. head is a sentinel node in all
+    // levels, level is the number of levels in use, n the
+    // number of keys and seed the state of the generator
+    // of node levels.
+    SkipNode *head;
+    int level, n;
+    uint64_t seed;
+} SkipList;
+
+/**
+ * Mixes the bits of a number (the SplitMix64 finalizer), so
+ * consecutive states of a generator give unrelated numbers.
+ */
+static inline uint64_t skipListMix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9UL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebUL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Turns a random number into a node level: 1 plus one level
+ * for each pair of trailing zero bits, up to the maximum.
+ */
+static inline int skipListLevel(uint64_t x) {
+    return 1 + __builtin_ctzll(x | (1UL << (2 * (SKIP_LIST_MAX_LEVEL - 1)))) / 2;
+}
+
+/**
+ * Walks the keys from low, included, to high, excluded, in
+ * ascending order.
+ */
+#define skipListForRange(p, list, low, high) \
+    for ((p) = seekSkipList((list), (low)); (p) && (p)->info < (high); (p) = (p)->next[0])
+
+// Exported names.
+#define createSkipList ads_skip_createSkipList
+#define freeSkipList   ads_skip_freeSkipList
+#define insertSkipList ads_skip_insertSkipList
+#define removeSkipList ads_skip_removeSkipList
+#define findSkipList   ads_skip_findSkipList
+#define seekSkipList   ads_skip_seekSkipList
+#define printSkipList  ads_skip_printSkipList
+
+int createSkipList(SkipList *list, uint64_t seed);
+void freeSkipList(SkipList *list);
+int insertSkipList(SkipList *list, int info);
+int removeSkipList(SkipList *list, int info);
+int findSkipList(const SkipList *list, int info);
+SkipNode *seekSkipList(const SkipList *list, int info);
+void printSkipList(const SkipList *list);
+
+#endif // SKIP_LIST_H
@@ -0,0 +1,298 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Snapshot.h"
+
+/******************************************************
+ ***************** FORMAT *****************************
+ ******************************************************/
+typedef struct {
+    // Defines the header of a snapshot file (see Snapshot.h).
+    char magic[8];
+    uint32_t version, kind, elementSize, byteOrder;
+    uint64_t n, checksum;
+    char reserved[24];
+} Header;
+
+_Static_assert(sizeof(Header) == SNAPSHOT_HEADER_SIZE, "snapshot header size");
+
+static const char magic[8] = "ADSSNAP";
+
+#define BYTE_ORDER_MARK 0x01020304u
+
+/**
+ * Computes the checksum of the elements of a snapshot.
+ *
+ * It is the 64-bit FNV-1a hash of the sequence of ints, taken
+ * one int at a time instead of one byte at a time, so it costs
+ * a multiplication per element.
+ *
+ * @param info: A pointer to the elements.
+ * @param n: The number of elements.
+ * @return the checksum.
+ */
+static uint64_t checksum(const int *info, long n) {
+    uint64_t hash = 14695981039346656037UL;
+    long i;
+
+    for (i = 0; i < n; i++) {
+        hash = (hash ^ (uint32_t) info[i]) * 1099511628211UL;
+    }
+
+    return hash;
+}
+
+/******************************************************
+ ***************** WRITING ****************************
+ ******************************************************/
+/**
+ * Writes a whole buffer to a file, retrying short writes.
+ *
+ * @param fd: The file descriptor.
+ * @param buffer: A pointer to the bytes to be written.
+ * @param size: The number of bytes.
+ * @return 1 if successful, 0 otherwise.
+ */
+static int writeAll(int fd, const void *buffer, size_t size) {
+    const char *p = (const char *) buffer;
+    ssize_t written;
+
+    while (size > 0) {
+        if ((written = write(fd, p, size)) <= 0) {
+            return 0;
+        }
+
+        p += written;
+        size -= written;
+    }
+
+    return 1;
+}
+
+/**
+ * Flushes to the disk the directory a file is in, so a
+ * rename of the file survives a crash.
+ *
+ * @param path: The name of the file.
+ * @return 1 if successful, 0 otherwise.
+ */
+static int syncDirectory(const char *path) {
+    const char *slash;
+    char *directory;
+    size_t length;
+    int fd, ok;
+
+    // Keeps the directory part with its slash, so a file in
+    // the root gives "/." and a file with no directory ".".
+    slash = strrchr(path, '/');
+    length = slash ? (size_t) (slash - path) + 1 : 0;
+
+    directory = (char *) malloc(length + 2);
+    if (!directory) {
+        return 0;
+    }
+    memcpy(directory, path, length);
+    strcpy(directory + length, ".");
+
+    fd = open(directory, O_RDONLY);
+    free(directory);
+    if (fd < 0) {
+        return 0;
+    }
+
+    ok = fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+
+    return ok;
+}
+
+/**
+ * Writes a snapshot file.
+ *
+ * The file is written under a unique temporary name in the
+ * same directory, flushed to the disk and then renamed, and
+ * the directory is flushed too, so a crash never leaves a
+ * partial snapshot in place of the previous one, and writers
+ * of the same path never share a temporary file.
+ *
+ * @param path: The name of the file.
+ * @param kind: The kind of container the elements come from.
+ * @param info: A pointer to the elements, in the layout of
+ * the container.
+ * @param n: The number of elements.
+ * @return 1 if successful, 0 otherwise.
+ */
+int writeSnapshot(const char *path, SnapshotKind kind, const int *info, long n) {
+    Header header;
+    char *temporary;
+    int fd, ok;
+
+    if (!path || n < 0 || (n > 0 && !info)) {
+        return 0;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, magic, sizeof(magic));
+    header.version = SNAPSHOT_VERSION;
+    header.kind = kind;
+    header.elementSize = sizeof(int);
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.n = n;
+    header.checksum = checksum(info, n);
+
+    temporary = (char *) malloc(strlen(path) + 8);
+    if (!temporary) {
+        return 0;
+    }
+    sprintf(temporary, "%s.XXXXXX", path);
+
+    if ((fd = mkstemp(temporary)) < 0) {
+        free(temporary);
+        return 0;
+    }
+
+    // mkstemp creates the file readable by its owner only.
+    ok = fchmod(fd, 0644) == 0
+        && writeAll(fd, &header, sizeof(header))
+        && writeAll(fd, info, sizeof(int) * n)
+        && fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+    ok = ok && rename(temporary, path) == 0;
+
+    if (!ok) {
+        unlink(temporary);
+    }
+    free(temporary);
+
+    return ok && syncDirectory(path);
+}
+
+/******************************************************
+ ***************** MAPPING ****************************
+ ******************************************************/
+/**
+ * Maps a snapshot file into memory.
+ *
+ * It takes O(1), no matter the size of the snapshot, unless
+ * it is verified: elements are only read from the disk when
+ * they are first accessed. The header is checked, and so is
+ * the checksum of the elements if mode has SNAPSHOT_VERIFY.
+ *
+ * @param snapshot: A pointer to the snapshot to be initialized.
+ * @param path: The name of the file.
+ * @param kind: The kind of container the snapshot must hold.
+ * @param mode: SNAPSHOT_READ_ONLY or SNAPSHOT_COPY_ON_WRITE,
+ * optionally with SNAPSHOT_VERIFY.
+ * @return 1 if successful, 0 if the file could not be mapped
+ * or is not a valid snapshot of the given kind.
+ */
+int mapSnapshot(Snapshot *snapshot, const char *path, SnapshotKind kind, int mode) {
+    const Header *header;
+    struct stat status;
+    void *base;
+    size_t length;
+    int fd, protection, flags;
+
+    if (!snapshot || !path) {
+        return 0;
+    }
+
+    if ((fd = open(path, O_RDONLY)) < 0) {
+        return 0;
+    }
+
+    if (fstat(fd, &status) < 0 || status.st_size < SNAPSHOT_HEADER_SIZE) {
+        close(fd);
+        return 0;
+    }
+    length = status.st_size;
+
+    // Private mappings can be written without changing the file.
+    if (mode & SNAPSHOT_COPY_ON_WRITE) {
+        protection = PROT_READ | PROT_WRITE;
+        flags = MAP_PRIVATE;
+    }
+    else {
+        protection = PROT_READ;
+        flags = MAP_SHARED;
+    }
+
+    base = mmap(NULL, length, protection, flags, fd, 0);
+    close(fd); // The mapping keeps the file open.
+
+    if (base == MAP_FAILED) {
+        return 0;
+    }
+
+    header = (const Header *) base;
+    if (memcmp(header->magic, magic, sizeof(magic)) != 0
+            || header->version != SNAPSHOT_VERSION
+            || header->kind != (uint32_t) kind
+            || header->elementSize != sizeof(int)
+            || header->byteOrder != BYTE_ORDER_MARK
+            || header->n > (length - SNAPSHOT_HEADER_SIZE) / sizeof(int)
+            || SNAPSHOT_HEADER_SIZE + header->n * sizeof(int) != length
+            || ((mode & SNAPSHOT_VERIFY) && checksum((const int *) (header + 1),
+                    header->n) != header->checksum)) {
+        munmap(base, length);
+        return 0;
+    }
+
+    snapshot->base = base;
+    snapshot->length = length;
+    snapshot->info = (int *) ((char *) base + SNAPSHOT_HEADER_SIZE);
+    snapshot->n = header->n;
+
+    return 1;
+}
+
+/**
+ * Unmaps a snapshot. Containers mapped from it must not be
+ * used anymore.
+ *
+ * @param snapshot: A pointer to the snapshot.
+ */
+void unmapSnapshot(Snapshot *snapshot) {
+    if (snapshot && snapshot->base) {
+        munmap(snapshot->base, snapshot->length);
+        snapshot->base = NULL;
+        snapshot->length = 0;
+        snapshot->info = NULL;
+        snapshot->n = 0;
+    }
+}
+
+/******************************************************
+ ***************** SEARCH *****************************
+ ******************************************************/
+/**
+ * Searches for a key in a snapshot of sorted elements, such
+ * as the keys of a tree, with a binary search in place.
+ *
+ * @param snapshot: A pointer to the snapshot.
+ * @param key: The value to be searched.
+ * @return the position of the first element equal to key,
+ * or -1 if there is none.
+ */
+long searchSnapshot(const Snapshot *snapshot, int key) {
+    long low = 0, high = snapshot->n, middle;
+
+    // Finds the first element not lesser than key.
+    while (low < high) {
+        middle = low + (high - low) / 2;
+
+        if (snapshot->info[middle] < key) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    return low < snapshot->n && snapshot->info[low] == key ? low : -1;
+}
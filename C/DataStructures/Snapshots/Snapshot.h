@@ -0,0 +1,76 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Snapshots are files holding the ints of a container, so it
+// can be mapped back into memory with mmap and used in place,
+// in O(1), instead of being rebuilt. The file has a header of
+// SNAPSHOT_HEADER_SIZE bytes followed by the ints, in the
+// layout of the container they come from:
+//
+//     offset  size
+//          0     8  magic, "ADSSNAP" and a NUL
+//          8     4  format version, SNAPSHOT_VERSION
+//         12     4  kind of container (SnapshotKind)
+//         16     4  size of each element, sizeof(int)
+//         20     4  0x01020304, written in the byte order
+//                   of the machine that saved it
+//         24     8  number of elements
+//         32     8  checksum of the elements
+//         40    24  zero
+//
+// Snapshots are only read back on machines with the same int
+// size and byte order. The header is always checked when the
+// file is mapped, and the checksum only on request, since it
+// needs reading all elements (see SNAPSHOT_VERIFY).
+//
+// Mapped containers point into the mapping. They must not grow,
+// shrink or be freed, and the snapshot must be unmapped after
+// the last use. In read-only mode, changing an element crashes
+// the program. In copy-on-write mode, elements can be changed
+// in place, and the changes stay private to the process and are
+// never written to the file. Loading instead of mapping copies
+// the elements into an ordinary container.
+
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_HEADER_SIZE 64
+
+typedef enum {
+    SNAPSHOT_ARRAY = 1,
+    SNAPSHOT_MAX_HEAP = 2,
+    SNAPSHOT_MIN_HEAP = 3,
+    SNAPSHOT_SORTED_KEYS = 4 // In-order keys of a binary search tree.
+} SnapshotKind;
+
+// Mapping modes. SNAPSHOT_VERIFY can be added to either one.
+#define SNAPSHOT_READ_ONLY     0
+#define SNAPSHOT_COPY_ON_WRITE 1
+#define SNAPSHOT_VERIFY        2
+
+typedef struct snapshot {
+    // Defines a mapped snapshot. info points to its n
+    // elements, inside the mapping of length bytes that
+    // starts at base.
+    void *base;
+    size_t length;
+    int *info;
+    long n;
+} Snapshot;
+
+// Exported names.
+#define writeSnapshot  ads_snapshot_writeSnapshot
+#define mapSnapshot    ads_snapshot_mapSnapshot
+#define unmapSnapshot  ads_snapshot_unmapSnapshot
+#define searchSnapshot ads_snapshot_searchSnapshot
+
+int writeSnapshot(const char *path, SnapshotKind kind, const int *info, long n);
+int mapSnapshot(Snapshot *snapshot, const char *path, SnapshotKind kind, int mode);
+void unmapSnapshot(Snapshot *snapshot);
+long searchSnapshot(const Snapshot *snapshot, int key);
+
+#endif // SNAPSHOT_H
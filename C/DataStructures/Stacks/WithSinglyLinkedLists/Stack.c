@@ -16,7 +16,8 @@
  */
 void createStack(Stack *s) {
     if (s) {
-        s->data = s->front = NULL;
+        createList(&(s->data));
+        s->front = NULL;
     }
 }
 
@@ -26,7 +27,8 @@ void createStack(Stack *s) {
  * @param q: A pointer to the stack.
  */
 void freeStack(Stack *s) {
-    freeList(s->data);
+    clearList(&(s->data));
+    s->front = NULL;
 }
 
 /******************************************************
@@ -43,12 +45,13 @@ void freeStack(Stack *s) {
  * @param info the element to be stacked.
  * @return 1 if it was successfully stacked, 0 otherwise.
  */
-int push(Stack *s, int info) {
+int pushStack(Stack *s, int info) {
     Node *newNode = createNode(info);
 
     if (newNode) {
         // Insert new node in the beginning of the stack.
-        s->front = s->data = insertBeginning(s->data, newNode);
+        insertBeginningList(&(s->data), newNode);
+        s->front = s->data.head;
 
         return 1;
     }
@@ -65,7 +68,7 @@ int push(Stack *s, int info) {
  * @param s: A pointer to the stack.
  * @return the front node.
  */
-Node *pop(Stack *s) {
+Node *popStack(Stack *s) {
     Node *front;
 
     if (!s) {
@@ -73,10 +76,10 @@ Node *pop(Stack *s) {
     }
 
     // Pops first node in the linked list (the stack top).
-    front = popFirstNode(&(s->data));
+    front = popFirstNodeList(&(s->data));
 
     // Adjust front pointer.
-    s->front = s->data;
+    s->front = s->data.head;
 
     return front;
 }
@@ -93,5 +96,5 @@ Node *pop(Stack *s) {
  * @param s: The stack.
  */
 void printStack(Stack s) {
-    printList(s.data);
+    printList(s.data.head);
 }
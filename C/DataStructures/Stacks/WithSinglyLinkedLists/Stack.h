@@ -1,12 +1,33 @@
+#ifndef STACK_H
+#define STACK_H
+
 #include "../../LinkedLists/SinglyLinkedLists/SinglyLinkedList.h"
 
 typedef struct {
-    Node *data;
+    // Defines a stack. data holds its elements from the
+    // top down, and knows its size.
+    List data;
     Node *front;
 } Stack;
 
+// Exported names.
+#define createStack ads_stack_createStack
+#define freeStack   ads_stack_freeStack
+#define pushStack   ads_stack_pushStack
+#define popStack    ads_stack_popStack
+#define printStack  ads_stack_printStack
+
 void createStack(Stack *s);
 void freeStack(Stack *s);
-int push(Stack *s, int info);
-Node *pop(Stack *s);
+int pushStack(Stack *s, int info);
+Node *popStack(Stack *s);
 void printStack(Stack s);
+
+// The names these functions had before, for code written against
+// them. They are common words, so they are opt-in.
+#ifdef ADS_SHORT_NAMES
+#define push pushStack
+#define pop  popStack
+#endif
+
+#endif // STACK_H
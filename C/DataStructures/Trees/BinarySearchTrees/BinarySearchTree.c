@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include "BinarySearchTree.h"
 
+// Searches interleaved by findMany, about as many cache misses
+// as a core can wait on at once.
+#define FIND_GROUP 16
+
 /******************************************************
  ***************** MEMORY MANAGEMENT ******************
  ******************************************************/
@@ -166,6 +170,243 @@ Node *removeNode(Node *root, int info) {
     return p;
 }
 
+/******************************************************
+ ***************** SEARCH *****************************
+ ******************************************************/
+/**
+ * Searches for a node according to its info value.
+ *
+ * @param root: A pointer to the tree root.
+ * @param info: The value to be searched.
+ * @return a pointer to the first node found with the value,
+ * the same one removeNode would remove, or NULL if there is
+ * none.
+ */
+Node *findNode(Node *root, int info) {
+    while (root && root->info != info) {
+        root = info < root->info ? root->left : root->right;
+    }
+
+    return root;
+}
+
+/**
+ * Searches for many values at once (see findNode).
+ *
+ * A single search waits for each node it visits to come from
+ * memory before it can pick the next one. This one runs up to
+ * FIND_GROUP searches in turns: each takes one step and
+ * prefetches its next node, which usually arrived by its next
+ * turn, so the waits of the group overlap. Each search is a
+ * small state machine, the node it is at, so when one ends,
+ * another one starts in its place, however deep they go.
+ *
+ * @param root: A pointer to the tree root.
+ * @param keys: A pointer to the values to be searched.
+ * @param n: The number of values.
+ * @param results: A pointer to store the node found for each
+ * value, NULL when it is not in the tree.
+ */
+void findMany(Node *root, const int *keys, long n, Node **results) {
+    Node *p[FIND_GROUP];
+    long index[FIND_GROUP], next;
+    int active, j;
+
+    for (active = 0; active < FIND_GROUP && active < n; active++) {
+        p[active] = root;
+        index[active] = active;
+    }
+    next = active;
+
+    while (active > 0) {
+        for (j = 0; j < active; j++) {
+            if (p[j] && p[j]->info != keys[index[j]]) {
+                p[j] = keys[index[j]] < p[j]->info ? p[j]->left : p[j]->right;
+                __builtin_prefetch(p[j]);
+                continue;
+            }
+
+            // The search is over, so another one takes its place,
+            // or the last one, which takes its turn now.
+            results[index[j]] = p[j];
+            if (next < n) {
+                p[j] = root;
+                index[j] = next++;
+            }
+            else {
+                active--;
+                p[j] = p[active];
+                index[j] = index[active];
+                j--;
+            }
+        }
+    }
+}
+
+/******************************************************
+ ***************** SNAPSHOTS **************************
+ ******************************************************/
+/**
+ * Walks the tree in-order, storing its keys.
+ *
+ * It uses Morris traversal: the greatest node of each left
+ * subtree is temporarily linked to its successor, so the walk
+ * needs no stack, however deep the tree is. All links are
+ * restored by the end of the walk.
+ *
+ * @param root: A pointer to the tree root.
+ * @param keys: A pointer to an array with room for all keys,
+ * or NULL to only count them.
+ * @return the number of keys.
+ */
+long inOrderKeys(Node *root, int *keys) {
+    Node *p;
+    long n = 0;
+
+    while (root) {
+        if (!root->left) {
+            if (keys) {
+                keys[n] = root->info;
+            }
+            n++;
+            root = root->right;
+            continue;
+        }
+
+        // Finds the predecessor of root.
+        p = root->left;
+        while (p->right && p->right != root) {
+            p = p->right;
+        }
+
+        if (!p->right) {
+            // First visit: links back to root and goes left.
+            p->right = root;
+            root = root->left;
+        }
+        else {
+            // Second visit: the left subtree is done.
+            p->right = NULL;
+            if (keys) {
+                keys[n] = root->info;
+            }
+            n++;
+            root = root->right;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * Builds a balanced tree with sorted keys.
+ *
+ * The middle key is the root, moved to the last one of its
+ * run of equal keys, so lesser or equal keys are still to the
+ * left. It takes O(n), and recursion is only as deep as the
+ * tree.
+ *
+ * @param keys: A pointer to the sorted keys.
+ * @param n: The number of keys.
+ * @param ok: A pointer to a flag cleared if memory could not
+ * be allocated.
+ * @return the pointer to the tree root.
+ */
+static Node *buildBalancedTree(const int *keys, long n, int *ok) {
+    Node *root;
+    long middle;
+
+    if (n <= 0 || !*ok) {
+        return NULL;
+    }
+
+    middle = n / 2;
+    while (middle + 1 < n && keys[middle + 1] == keys[middle]) {
+        middle++;
+    }
+
+    if (!(root = createNode(keys[middle]))) {
+        *ok = 0;
+        return NULL;
+    }
+
+    root->left = buildBalancedTree(keys, middle, ok);
+    root->right = buildBalancedTree(keys + middle + 1, n - middle - 1, ok);
+
+    return root;
+}
+
+/**
+ * Saves the keys of the tree in a snapshot file (see
+ * Snapshot.h), sorted, as the tree is read in-order.
+ *
+ * @param root: A pointer to the tree root.
+ * @param path: The name of the file.
+ * @return 1 if successful, 0 otherwise.
+ */
+int saveTree(Node *root, const char *path) {
+    long n = inOrderKeys(root, NULL);
+    int *keys, saved;
+
+    if (!(keys = (int *) malloc(sizeof(int) * (n > 0 ? n : 1)))) {
+        return 0;
+    }
+
+    inOrderKeys(root, keys);
+    saved = writeSnapshot(path, SNAPSHOT_SORTED_KEYS, keys, n);
+
+    free(keys);
+
+    return saved;
+}
+
+/**
+ * Maps a snapshot file of a tree, whose sorted keys are used
+ * in place.
+ *
+ * It takes O(1), no matter the size of the tree. There are no
+ * nodes: keys are searched with searchSnapshot, a binary search
+ * in the snapshot.
+ *
+ * @param snapshot: A pointer to the snapshot to be mapped.
+ * @param path: The name of the file.
+ * @param mode: The mapping mode (see Snapshot.h).
+ * @return 1 if successful, 0 otherwise.
+ */
+int mapTree(Snapshot *snapshot, const char *path, int mode) {
+    return mapSnapshot(snapshot, path, SNAPSHOT_SORTED_KEYS, mode);
+}
+
+/**
+ * Loads a snapshot file of a tree into a new tree.
+ *
+ * Keys are sorted, so the tree is built balanced in O(n),
+ * instead of in O(n log n) or worse by inserting them one by
+ * one. The snapshot is verified against its checksum.
+ *
+ * @param root: A pointer to store the new tree root.
+ * @param path: The name of the file.
+ * @return 1 if successful, 0 otherwise.
+ */
+int loadTree(Node **root, const char *path) {
+    Snapshot snapshot;
+    int ok = 1;
+
+    if (!root || !mapTree(&snapshot, path, SNAPSHOT_READ_ONLY | SNAPSHOT_VERIFY)) {
+        return 0;
+    }
+
+    *root = buildBalancedTree(snapshot.info, snapshot.n, &ok);
+    if (!ok) {
+        freeTree(*root);
+        *root = NULL;
+    }
+
+    unmapSnapshot(&snapshot);
+
+    return ok;
+}
+
 /******************************************************
  ***************** OUTPUT *****************************
  ******************************************************/
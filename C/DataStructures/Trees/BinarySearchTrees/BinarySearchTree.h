@@ -1,3 +1,8 @@
+#ifndef BINARY_SEARCH_TREE_H
+#define BINARY_SEARCH_TREE_H
+
+#include "../../Snapshots/Snapshot.h"
+
 #define IN_ORDER 1
 #define PRE_ORDER 2
 #define POST_ORDER 3
@@ -7,11 +12,36 @@ typedef struct node {
     int info;
 } Node;
 
+// Exported names. createNode and removeNode are also defined by
+// the linked lists.
+#define createNode        ads_bst_createNode
+#define freeTree          ads_bst_freeTree
+#define insertNode        ads_bst_insertNode
+#define removeNode        ads_bst_removeNode
+#define findNode          ads_bst_findNode
+#define findMany          ads_bst_findMany
+#define printBSTInOrder   ads_bst_printBSTInOrder
+#define printBSTPreOrder  ads_bst_printBSTPreOrder
+#define printBSTPostOrder ads_bst_printBSTPostOrder
+#define printBST          ads_bst_printBST
+#define saveTree          ads_bst_saveTree
+#define mapTree           ads_bst_mapTree
+#define loadTree          ads_bst_loadTree
+#define inOrderKeys       ads_bst_inOrderKeys
+
 Node *createNode(int info);
 void freeTree(Node *root);
 Node *insertNode(Node *root, Node *newNode);
 Node *removeNode(Node *root, int info);
+Node *findNode(Node *root, int info);
+void findMany(Node *root, const int *keys, long n, Node **results);
 void printBSTInOrder(Node *root);
 void printBSTPreOrder(Node *root);
 void printBSTPostOrder(Node *root);
 void printBST(Node *root, int traverse);
+int saveTree(Node *root, const char *path);
+int mapTree(Snapshot *snapshot, const char *path, int mode);
+int loadTree(Node **root, const char *path);
+long inOrderKeys(Node *root, int *keys);
+
+#endif // BINARY_SEARCH_TREE_H
@@ -0,0 +1,179 @@
+#ifndef BINARY_SEARCH_TREE_TEMPLATE_H
+#define BINARY_SEARCH_TREE_TEMPLATE_H
+
+#include <stdlib.h>
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Binary search trees of keys of any type, each one with a
+// value of any type. DEFINE_BST(K, V, cmp) generates the type
+// TreeNode_K_V and its functions, named after the ones of the
+// int tree (BinarySearchTree.h) followed by _K_V. They are
+// static inline, so each instantiation is compiled and inlined
+// for its own types where it is used, and cmp is called
+// directly instead of through a function pointer. The int tree
+// in libads stays the default.
+//
+// K and V must be single identifiers, so types such as
+// unsigned long or structs need a typedef first. cmp(a, b)
+// may be a macro or a function, and returns a negative number,
+// zero or a positive number when a is lesser than, equal to
+// or greater than b, as strcmp. ADS_COMPARE does it for
+// numbers. As in the int tree, lesser or equal keys go to the
+// left, and nothing is balanced. Values are stored in the
+// nodes, so finding a key also finds its value, and putTree
+// keeps one node per key, as a map.
+//
+// Example:
+//
+//     typedef const char *string;
+//
+//     DEFINE_BST(string, double, strcmp)
+//
+//     TreeNode_string_double *root = NULL, *p;
+//
+//     root = insertTreeNode_string_double(root, createTreeNode_string_double("pi", 3.14));
+//     putTree_string_double(&root, "e", 2.72);
+//     p = findTreeNode_string_double(root, "pi");
+//     root = removeTreeNode_string_double(root, "pi");
+//     freeTree_string_double(root);
+
+#ifndef ADS_COMPARE
+#define ADS_COMPARE(a, b) (((a) > (b)) - ((a) < (b)))
+#endif
+
+/******************************************************
+ ***************** TEMPLATE ***************************
+ ******************************************************/
+#define DEFINE_BST(K, V, cmp)                                                   \
+typedef struct treeNode_##K##_##V {                                             \
+    struct treeNode_##K##_##V *left, *right;                                    \
+    K key;                                                                      \
+    V value;                                                                    \
+} TreeNode_##K##_##V;                                                           \
+                                                                                \
+/* Creates a node holding a key and its value, or returns */                    \
+/* NULL if there is no memory. */                                               \
+static inline TreeNode_##K##_##V *createTreeNode_##K##_##V(K key, V value) {    \
+    TreeNode_##K##_##V *newNode =                                               \
+        (TreeNode_##K##_##V *) malloc(sizeof(TreeNode_##K##_##V));              \
+                                                                                \
+    if (newNode) {                                                              \
+        newNode->left = newNode->right = NULL;                                  \
+        newNode->key = key;                                                     \
+        newNode->value = value;                                                 \
+    }                                                                           \
+                                                                                \
+    return newNode;                                                             \
+}                                                                               \
+                                                                                \
+/* Frees all nodes of the tree. Left children are rotated to */                 \
+/* the right until the root has none, so it needs no stack */                   \
+/* however deep the tree is. */                                                 \
+static inline void freeTree_##K##_##V(TreeNode_##K##_##V *root) {               \
+    TreeNode_##K##_##V *p;                                                      \
+                                                                                \
+    while (root) {                                                              \
+        if (root->left) {                                                       \
+            p = root->left;                                                     \
+            root->left = p->right;                                              \
+            p->right = root;                                                    \
+            root = p;                                                           \
+        }                                                                       \
+        else {                                                                  \
+            p = root->right;                                                    \
+            free(root);                                                         \
+            root = p;                                                           \
+        }                                                                       \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+/* Returns the first node found with the given key, or NULL */                  \
+/* if there is none. */                                                         \
+static inline TreeNode_##K##_##V *findTreeNode_##K##_##V(                       \
+        TreeNode_##K##_##V *root, K key) {                                      \
+    int c;                                                                      \
+                                                                                \
+    while (root && (c = cmp(key, root->key)) != 0) {                            \
+        root = c < 0 ? root->left : root->right;                                \
+    }                                                                           \
+                                                                                \
+    return root;                                                                \
+}                                                                               \
+                                                                                \
+/* Inserts a node, with lesser or equal keys to the left. */                    \
+/* Returns the root of the tree. */                                             \
+static inline TreeNode_##K##_##V *insertTreeNode_##K##_##V(                     \
+        TreeNode_##K##_##V *root, TreeNode_##K##_##V *newNode) {                \
+    TreeNode_##K##_##V **link = &root;                                          \
+                                                                                \
+    while (*link) {                                                             \
+        link = cmp(newNode->key, (*link)->key) <= 0 ?                           \
+            &(*link)->left : &(*link)->right;                                   \
+    }                                                                           \
+    *link = newNode;                                                            \
+                                                                                \
+    return root;                                                                \
+}                                                                               \
+                                                                                \
+/* Sets the value of a key, storing it in the node of the key */                \
+/* if there is one, or in a new node otherwise, so a tree can */                \
+/* be used as a map. Returns 1 on success and 0 if there is */                  \
+/* no memory. */                                                                \
+static inline int putTree_##K##_##V(TreeNode_##K##_##V **root, K key, V value) { \
+    TreeNode_##K##_##V **link = root;                                           \
+    int c;                                                                      \
+                                                                                \
+    while (*link && (c = cmp(key, (*link)->key)) != 0) {                        \
+        link = c < 0 ? &(*link)->left : &(*link)->right;                        \
+    }                                                                           \
+                                                                                \
+    if (*link) {                                                                \
+        (*link)->value = value;                                                 \
+                                                                                \
+        return 1;                                                               \
+    }                                                                           \
+                                                                                \
+    return (*link = createTreeNode_##K##_##V(key, value)) != NULL;              \
+}                                                                               \
+                                                                                \
+/* Removes and frees the first node found with the given key, */                \
+/* replacing it by the greatest node of its left subtree if it */               \
+/* has both children. Returns the root of the tree. */                          \
+static inline TreeNode_##K##_##V *removeTreeNode_##K##_##V(                     \
+        TreeNode_##K##_##V *root, K key) {                                      \
+    TreeNode_##K##_##V **link = &root, **greatest, *node, *p;                   \
+    int c;                                                                      \
+                                                                                \
+    while (*link && (c = cmp(key, (*link)->key)) != 0) {                        \
+        link = c < 0 ? &(*link)->left : &(*link)->right;                        \
+    }                                                                           \
+                                                                                \
+    if (!(node = *link)) {                                                      \
+        return root;                                                            \
+    }                                                                           \
+                                                                                \
+    if (!node->left) {                                                          \
+        *link = node->right;                                                    \
+    }                                                                           \
+    else if (!node->right) {                                                    \
+        *link = node->left;                                                     \
+    }                                                                           \
+    else {                                                                      \
+        for (greatest = &node->left; (*greatest)->right;                        \
+             greatest = &(*greatest)->right);                                   \
+                                                                                \
+        p = *greatest;                                                          \
+        *greatest = p->left;                                                    \
+        p->left = node->left;                                                   \
+        p->right = node->right;                                                 \
+        *link = p;                                                              \
+    }                                                                           \
+                                                                                \
+    free(node);                                                                 \
+                                                                                \
+    return root;                                                                \
+}
+
+#endif // BINARY_SEARCH_TREE_TEMPLATE_H
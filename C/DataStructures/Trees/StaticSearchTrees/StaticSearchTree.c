@@ -0,0 +1,250 @@
+#include <stdlib.h>
+#include "StaticSearchTree.h"
+#include "../../DynamicArrays/DynamicArray.h"
+#include "../BinarySearchTrees/BinarySearchTree.h"
+
+// Size of a cache line, to which keys are aligned.
+#define CACHE_LINE 64
+
+// Keys searched at the same time by lowerBoundMany, about as
+// many cache misses as a core can wait on at once.
+#define LOOKUP_GROUP 16
+
+/******************************************************
+ ***************** AUXILIARY FUNCTIONS ****************
+ ******************************************************/
+/**
+ * Compares two ints, for qsort.
+ */
+static int compareInts(const void *a, const void *b) {
+    int x = *(const int *) a, y = *(const int *) b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * Finds the position of the lower bound from the position
+ * where a search left the tree.
+ *
+ * Each step down appends a bit to the position: 1 when the
+ * key at the node was lesser than the searched one, and 0
+ * otherwise. The lower bound is the last node where the search
+ * went left, so the trailing 1 bits and that 0 are removed.
+ *
+ * @param k: The position past the leaf the search ended at.
+ * @return the position of the lower bound, or 0 if the search
+ * never went left.
+ */
+static inline long lastLeftTurn(long k) {
+    return k >> __builtin_ffsl(~k);
+}
+
+/******************************************************
+ ***************** MEMORY MANAGEMENT ******************
+ ******************************************************/
+/**
+ * Creates a static search tree with sorted keys.
+ *
+ * The keys are copied in Eytzinger layout, in the order of an
+ * in-order walk of the implicit tree, in O(n). Repeated keys
+ * are allowed.
+ *
+ * @param tree: A pointer to the tree to be initialized.
+ * @param sorted: A pointer to the keys, in ascending order.
+ * @param n: The number of keys.
+ * @return 1 if successful, 0 if memory could not be allocated.
+ */
+int createStaticTree(StaticTree *tree, const int *sorted, long n) {
+    size_t size;
+    long i, k;
+
+    if (!tree || n < 0 || (n > 0 && !sorted)) {
+        return 0;
+    }
+
+    // Aligned, so the 16 keys in positions 16k to 16k + 15 share
+    // a cache line.
+    size = (sizeof(int) * (n + 1) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    if (!(tree->keys = (int *) aligned_alloc(CACHE_LINE, size))) {
+        return 0;
+    }
+    tree->n = n;
+
+    // Starts at the leftmost node and goes from each node to its
+    // successor: the leftmost node of its right subtree, or the
+    // first ancestor it is in the left subtree of.
+    for (k = 1; 2 * k <= n; k *= 2);
+    for (i = 0; i < n; i++) {
+        tree->keys[k] = sorted[i];
+
+        if (2 * k + 1 <= n) {
+            for (k = 2 * k + 1; 2 * k <= n; k *= 2);
+        }
+        else {
+            k >>= __builtin_ffsl(~k);
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * Creates a static search tree with the elements of an array,
+ * which is not changed. Unsorted elements are sorted in a copy
+ * first, in O(n log n).
+ *
+ * @param tree: A pointer to the tree to be initialized.
+ * @param array: A pointer to the array.
+ * @return 1 if successful, 0 if memory could not be allocated.
+ */
+int staticTreeFromArray(StaticTree *tree, const Array *array) {
+    int *sorted, created;
+    long i;
+
+    if (!array) {
+        return 0;
+    }
+
+    for (i = 1; i < array->n && array->info[i - 1] <= array->info[i]; i++);
+    if (i >= array->n) {
+        return createStaticTree(tree, array->info, array->n);
+    }
+
+    if (!(sorted = (int *) malloc(sizeof(int) * array->n))) {
+        return 0;
+    }
+    for (i = 0; i < array->n; i++) {
+        sorted[i] = array->info[i];
+    }
+    qsort(sorted, array->n, sizeof(int), compareInts);
+
+    created = createStaticTree(tree, sorted, array->n);
+    free(sorted);
+
+    return created;
+}
+
+/**
+ * Creates a static search tree with the keys of a binary
+ * search tree, which come sorted from an in-order walk, in
+ * O(n). The binary search tree is not changed.
+ *
+ * @param tree: A pointer to the tree to be initialized.
+ * @param root: A pointer to the binary search tree root.
+ * @return 1 if successful, 0 if memory could not be allocated.
+ */
+int staticTreeFromBST(StaticTree *tree, Node *root) {
+    long n = inOrderKeys(root, NULL);
+    int *sorted, created;
+
+    if (!(sorted = (int *) malloc(sizeof(int) * (n > 0 ? n : 1)))) {
+        return 0;
+    }
+
+    inOrderKeys(root, sorted);
+    created = createStaticTree(tree, sorted, n);
+    free(sorted);
+
+    return created;
+}
+
+/**
+ * Frees the memory used by a static search tree.
+ *
+ * @param tree: A pointer to the tree.
+ */
+void freeStaticTree(StaticTree *tree) {
+    if (tree) {
+        free(tree->keys);
+        tree->keys = NULL;
+        tree->n = 0;
+    }
+}
+
+/******************************************************
+ ***************** SEARCH *****************************
+ ******************************************************/
+/**
+ * Searches for the least key not lesser than key.
+ *
+ * The walk has no branches to mispredict, since each step
+ * computes the next position from the comparison. It takes
+ * O(log n) steps, with about one cache miss every four.
+ *
+ * @param tree: A pointer to the tree.
+ * @param key: The value to be searched.
+ * @return the position of the least key not lesser than key
+ * (the first of them, if repeated), or 0 if all keys are
+ * lesser.
+ */
+long lowerBound(const StaticTree *tree, int key) {
+    const int *keys = tree->keys;
+    long k = 1;
+
+    while (k <= tree->n) {
+        __builtin_prefetch(keys + 16 * k);
+        k = 2 * k + (keys[k] < key);
+    }
+
+    return lastLeftTurn(k);
+}
+
+/**
+ * Searches for the lower bound of many keys (see lowerBound).
+ *
+ * Keys are searched in groups of LOOKUP_GROUP, level by level:
+ * each search takes one step and prefetches its next node, and
+ * by the time it takes the next step, after all others in the
+ * group, the node is usually in the cache. So the cache misses
+ * of the group overlap, instead of following one another.
+ *
+ * @param tree: A pointer to the tree.
+ * @param keys: A pointer to the values to be searched.
+ * @param n: The number of values.
+ * @param results: A pointer to store the position found for
+ * each value.
+ */
+void lowerBoundMany(const StaticTree *tree, const int *keys, long n, long *results) {
+    const int *tkeys = tree->keys;
+    long k[LOOKUP_GROUP], i, j, m;
+    int levels, level;
+
+    // All levels above the last one are complete.
+    levels = 63 - __builtin_clzl(tree->n + 1);
+
+    for (i = 0; i < n; i += LOOKUP_GROUP) {
+        m = n - i < LOOKUP_GROUP ? n - i : LOOKUP_GROUP;
+
+        for (j = 0; j < m; j++) {
+            k[j] = 1;
+        }
+
+        for (level = 0; level < levels; level++) {
+            for (j = 0; j < m; j++) {
+                k[j] = 2 * k[j] + (tkeys[k[j]] < keys[i + j]);
+                __builtin_prefetch(tkeys + k[j]);
+            }
+        }
+
+        for (j = 0; j < m; j++) {
+            if (k[j] <= tree->n) {
+                k[j] = 2 * k[j] + (tkeys[k[j]] < keys[i + j]);
+            }
+            results[i + j] = lastLeftTurn(k[j]);
+        }
+    }
+}
+
+/**
+ * Searches for a key.
+ *
+ * @param tree: A pointer to the tree.
+ * @param key: The value to be searched.
+ * @return the position of the key, or 0 if it is not in the
+ * tree.
+ */
+long findStaticTree(const StaticTree *tree, int key) {
+    long k = lowerBound(tree, key);
+
+    return k && tree->keys[k] == key ? k : 0;
+}
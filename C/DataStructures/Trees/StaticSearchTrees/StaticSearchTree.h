@@ -0,0 +1,49 @@
+#ifndef STATIC_SEARCH_TREE_H
+#define STATIC_SEARCH_TREE_H
+
+/******************************************************
+ ***************** DEFINITIONS ************************
+ ******************************************************/
+// Static search trees hold a sorted set of ints that does not
+// change after it is built, for fast searches. Keys are stored
+// in an array in Eytzinger layout, the order of a breadth-first
+// walk of a balanced tree: the root is in position 1, and the
+// children of position k are in 2k and 2k + 1. There are no
+// pointers, the top levels share a few cache lines, and each
+// search prefetches the cache line of the 16 descendants of its
+// node four levels below, so it waits on memory about once every
+// four levels instead of on every level, as binary search on a
+// sorted array or a walk down a BinarySearchTree do.
+//
+// Searches return positions in keys, from 1 to n, or 0 when no
+// key qualifies. Batched searches interleave the walks of several
+// keys, so their cache misses overlap.
+
+struct array;
+struct node;
+
+typedef struct staticTree {
+    // Defines a static search tree. keys[1] to keys[n] are
+    // the keys in Eytzinger layout, and keys[0] is unused.
+    int *keys;
+    long n;
+} StaticTree;
+
+// Exported names.
+#define createStaticTree    ads_sst_createStaticTree
+#define staticTreeFromArray ads_sst_staticTreeFromArray
+#define staticTreeFromBST   ads_sst_staticTreeFromBST
+#define freeStaticTree      ads_sst_freeStaticTree
+#define lowerBound          ads_sst_lowerBound
+#define lowerBoundMany      ads_sst_lowerBoundMany
+#define findStaticTree      ads_sst_findStaticTree
+
+int createStaticTree(StaticTree *tree, const int *sorted, long n);
+int staticTreeFromArray(StaticTree *tree, const struct array *array);
+int staticTreeFromBST(StaticTree *tree, struct node *root);
+void freeStaticTree(StaticTree *tree);
+long lowerBound(const StaticTree *tree, int key);
+void lowerBoundMany(const StaticTree *tree, const int *keys, long n, long *results);
+long findStaticTree(const StaticTree *tree, int key);
+
+#endif // STATIC_SEARCH_TREE_H